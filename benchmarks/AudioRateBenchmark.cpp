@@ -0,0 +1,99 @@
+#include "Benchmark.hpp"
+#include "StreamProcessor.hpp"
+
+static auto getShapeName(LFOShape shape) -> String {
+    switch (shape) {
+        case LFOShape::square: return "square";
+        case LFOShape::saw: return "saw";
+        case LFOShape::triangle: return "triangle";
+        case LFOShape::sine: return "sine";
+    }
+    return {};
+}
+
+// Oscillator cost per sample: the naive renderLFO kernel and the band-limited one
+template <typename SampleType>
+static auto runOscillatorBenchmark(LFOShape shape, double frequency, double sampleRate, int blockSize, int numBlocks) -> void {
+    std::vector<SampleType> dest(static_cast<size_t>(blockSize));
+    const auto& kernels = Kernels::getTable<SampleType>(Kernels::detectISA());
+    auto increment = static_cast<SampleType>(frequency / sampleRate);
+    auto samples = static_cast<double>(blockSize) * numBlocks;
+
+    SampleType phase = SampleType(0);
+    double naiveCost = Benchmark::measureNanoseconds([&] {
+        for (int block = 0; block < numBlocks; block++) {
+            phase = kernels.renderLFO(dest.data(), phase, increment, shape, true, blockSize);
+        }
+    });
+
+    phase = SampleType(0);
+    double bandlimitedCost = Benchmark::measureNanoseconds([&] {
+        for (int block = 0; block < numBlocks; block++) {
+            phase = kernels.renderOscillator(dest.data(), phase, increment, shape, true, blockSize);
+        }
+    });
+
+    std::cout << getShapeName(shape) << std::endl;
+    Benchmark::printRow("  renderLFO ns/sample", naiveCost / samples, "ns");
+    Benchmark::printRow("  renderOscillator ns/sample", bandlimitedCost / samples, "ns");
+}
+
+// Full stream cost with the gain LFO synced at 1/8 against the free-running modes at audio rate
+template <typename SampleType>
+static auto runStreamBenchmark(LFOMode mode, double frequency, double sampleRate, int blockSize, int numBlocks) -> double {
+    StreamProcessor<SampleType> stream;
+    stream.prepare(sampleRate, blockSize, Kernels::detectISA());
+
+    StreamParameters parameters;
+    parameters.gainLFOType = LFOShape::saw;
+    parameters.gainLFORate = 0.125f;
+    parameters.gainLFOAmount = 1.0f;
+    parameters.gainLFOMode = mode;
+    parameters.gainLFOFrequency = static_cast<float>(frequency);
+    parameters.panLFOAmount = 0.5f;
+    stream.reset(parameters);
+
+    AudioBuffer<SampleType> input{2, blockSize};
+    AudioBuffer<SampleType> output{2, blockSize};
+    Random random{1234};
+    Benchmark::fillWithNoise(input, random);
+
+    double totalNanoseconds = Benchmark::measureNanoseconds([&] {
+        for (int block = 0; block < numBlocks; block++) {
+            stream.setParameters(parameters);
+            stream.process(input.getReadPointer(0), input.getReadPointer(1), output.getWritePointer(0),
+                output.getWritePointer(1), blockSize);
+        }
+    });
+
+    return totalNanoseconds / (static_cast<double>(blockSize) * numBlocks);
+}
+
+auto AudioRateBenchmark::command() -> ConsoleApplication::Command {
+    return {
+        "audio-rate",
+        "audio-rate [--block-size=512] [--blocks=20000] [--frequency=2000]",
+        "Compares the free-running audio-rate gain LFO against the synced path",
+        "Times the naive renderLFO kernel and the band-limited renderOscillator kernel for "
+        "each shape at the given frequency, then runs a stream with the gain LFO synced, in tremolo mode and in "
+        "ring mode, reporting the cost per sample.",
+        [](const ArgumentList& args) {
+            int blockSize = Benchmark::getIntOption(args, "--block-size", 512);
+            int numBlocks = Benchmark::getIntOption(args, "--blocks", 20000);
+            double frequency = static_cast<double>(Benchmark::getIntOption(args, "--frequency", 2000));
+            double sampleRate = 48000.0;
+
+            std::cout << "Selected kernels: " << Kernels::getISAName(Kernels::detectISA()) << std::endl;
+            std::cout << "Oscillators at " << frequency << " Hz" << std::endl;
+
+            for (auto shape : {LFOShape::square, LFOShape::saw, LFOShape::triangle, LFOShape::sine}) {
+                runOscillatorBenchmark<float>(shape, frequency, sampleRate, blockSize, numBlocks);
+            }
+
+            std::cout << "Stream, saw gain LFO" << std::endl;
+            Benchmark::printRow("  synced 1/8 ns/sample", runStreamBenchmark<float>(LFOMode::synced, frequency, sampleRate, blockSize, numBlocks), "ns");
+            Benchmark::printRow("  tremolo ns/sample", runStreamBenchmark<float>(LFOMode::tremolo, frequency, sampleRate, blockSize, numBlocks), "ns");
+            Benchmark::printRow("  ring ns/sample", runStreamBenchmark<float>(LFOMode::ring, frequency, sampleRate, blockSize, numBlocks), "ns");
+        }
+    };
+}
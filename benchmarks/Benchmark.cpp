@@ -0,0 +1,51 @@
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__APPLE__)
+    #include <mach/mach.h>
+    #include <sys/resource.h>
+#else
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+#include "Benchmark.hpp"
+
+auto Benchmark::getResidentBytes() -> int64 {
+    #if JUCE_MAC
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) return 0;
+        return static_cast<int64>(info.resident_size);
+    #elif JUCE_LINUX || JUCE_BSD
+        auto fields = StringArray::fromTokens(File{"/proc/self/statm"}.loadFileAsString(), false);
+        if (fields.size() < 2) return 0;
+        return fields[1].getLargeIntValue() * static_cast<int64>(sysconf(_SC_PAGESIZE));
+    #elif JUCE_WINDOWS
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return static_cast<int64>(counters.WorkingSetSize);
+    #else
+        return 0;
+    #endif
+}
+
+auto Benchmark::getPeakResidentBytes() -> int64 {
+    #if JUCE_MAC
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<int64>(usage.ru_maxrss);
+    #elif JUCE_LINUX || JUCE_BSD
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<int64>(usage.ru_maxrss) * 1024;
+    #elif JUCE_WINDOWS
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return static_cast<int64>(counters.PeakWorkingSetSize);
+    #else
+        return 0;
+    #endif
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <JuceHeader.h>
+#include <chrono>
+
+class Benchmark {
+public:
+    template <typename Callback>
+    static auto measureNanoseconds(Callback&& callback) -> double {
+        auto start = std::chrono::steady_clock::now();
+        callback();
+        auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    template <typename SampleType>
+    static auto fillWithNoise(AudioBuffer<SampleType>& buffer, Random& random) -> void {
+        for (int channel = 0; channel < buffer.getNumChannels(); channel++) {
+            auto* channelData = buffer.getWritePointer(channel);
+            for (int sample = 0; sample < buffer.getNumSamples(); sample++) {
+                channelData[sample] = static_cast<SampleType>(random.nextFloat() * 2.0f - 1.0f) * SampleType(0.5);
+            }
+        }
+    }
+
+    static auto getIntOption(const ArgumentList& args, const String& option, int defaultValue) -> int {
+        auto value = args.getValueForOption(option);
+        return value.isEmpty() ? defaultValue : value.getIntValue();
+    }
+
+    static auto getResidentBytes() -> int64;
+    static auto getPeakResidentBytes() -> int64;
+
+    static auto printRow(const String& label, double value, const String& unit) -> void {
+        std::cout << label.paddedRight(' ', 32) << String(value, 3).paddedLeft(' ', 14) << " " << unit << std::endl;
+    }
+};
+
+class ProcessBenchmark {
+public:
+    static auto command() -> ConsoleApplication::Command;
+};
+
+class KernelBenchmark {
+public:
+    static auto command() -> ConsoleApplication::Command;
+};
+
+class InstanceBenchmark {
+public:
+    static auto command() -> ConsoleApplication::Command;
+};
+
+class GraphBenchmark {
+public:
+    static auto command() -> ConsoleApplication::Command;
+};
+
+class InterleavedBenchmark {
+public:
+    static auto command() -> ConsoleApplication::Command;
+};
+
+class PresetBenchmark {
+public:
+    static auto command() -> ConsoleApplication::Command;
+};
+
+class SearchBenchmark {
+public:
+    static auto command() -> ConsoleApplication::Command;
+};
+
+class AudioRateBenchmark {
+public:
+    static auto command() -> ConsoleApplication::Command;
+};
@@ -0,0 +1,181 @@
+#include "Benchmark.hpp"
+#include "Processor.h"
+#include <deque>
+
+// Renders the parallel instance branches of a graph on a thread pool, each worker sums into its own bus
+class ParallelBranchRenderer {
+public:
+    ParallelBranchRenderer(const std::vector<AudioProcessor*>& processors, int numThreads, int blockSize)
+        : processors(processors), pool(ThreadPoolOptions{}.withThreadName("Graph Worker").withNumberOfThreadsToUse(numThreads)) {
+        int numWorkers = jmin(numThreads, static_cast<int>(processors.size()));
+
+        for (int worker = 0; worker < numWorkers; worker++) {
+            auto& bus = this->workers.emplace_back();
+            bus.scratch.setSize(2, blockSize);
+            bus.sum.setSize(2, blockSize);
+            bus.first = worker * static_cast<int>(processors.size()) / numWorkers;
+            bus.last = (worker + 1) * static_cast<int>(processors.size()) / numWorkers;
+        }
+    }
+
+    auto process(const AudioBuffer<float>& input, AudioBuffer<float>& output) -> double {
+        this->remaining.store(static_cast<int>(this->workers.size()));
+        this->busyNanoseconds.store(0);
+
+        for (auto& worker : this->workers) {
+            this->pool.addJob([this, &worker, &input] {
+                double elapsed = Benchmark::measureNanoseconds([&] { this->renderBranches(worker, input); });
+                this->busyNanoseconds.fetch_add(static_cast<int64>(elapsed), std::memory_order_relaxed);
+                if (this->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) this->finished.signal();
+            });
+        }
+
+        this->finished.wait();
+
+        output.clear();
+        for (auto& worker : this->workers) {
+            for (int channel = 0; channel < output.getNumChannels(); channel++) {
+                output.addFrom(channel, 0, worker.sum, channel, 0, output.getNumSamples());
+            }
+        }
+
+        return static_cast<double>(this->busyNanoseconds.load());
+    }
+
+private:
+    struct Worker {
+        AudioBuffer<float> scratch;
+        AudioBuffer<float> sum;
+        MidiBuffer midi;
+        int first = 0;
+        int last = 0;
+    };
+
+    std::vector<AudioProcessor*> processors;
+    std::deque<Worker> workers;
+    std::atomic<int> remaining{0};
+    std::atomic<int64> busyNanoseconds{0};
+    WaitableEvent finished;
+    ThreadPool pool;
+
+    auto renderBranches(Worker& worker, const AudioBuffer<float>& input) -> void {
+        int numSamples = input.getNumSamples();
+        worker.sum.clear();
+
+        for (int index = worker.first; index < worker.last; index++) {
+            for (int channel = 0; channel < 2; channel++) {
+                worker.scratch.copyFrom(channel, 0, input, channel, 0, numSamples);
+            }
+
+            this->processors[static_cast<size_t>(index)]->processBlock(worker.scratch, worker.midi);
+
+            for (int channel = 0; channel < 2; channel++) {
+                worker.sum.addFrom(channel, 0, worker.scratch, channel, 0, numSamples);
+            }
+        }
+    }
+};
+
+static auto parseIntList(const String& list) -> std::vector<int> {
+    std::vector<int> values;
+    for (const auto& token : StringArray::fromTokens(list, ",", "")) {
+        if (token.getIntValue() > 0) values.push_back(token.getIntValue());
+    }
+    return values;
+}
+
+static auto runGraphBenchmark(int numInstances, int numThreads, int blockSize, int numBlocks, double sampleRate) -> void {
+    auto memoryBefore = Benchmark::getResidentBytes();
+
+    AudioProcessorGraph graph;
+    graph.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+
+    auto input = graph.addNode(std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor>(
+        AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode));
+    auto output = graph.addNode(std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor>(
+        AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode));
+
+    Random random{1234};
+    std::vector<AudioProcessor*> processors;
+
+    for (int i = 0; i < numInstances; i++) {
+        auto processor = std::make_unique<Processor>();
+        processor->parameters.gainParam->setValueNotifyingHost(random.nextFloat());
+        processor->parameters.panParam->setValueNotifyingHost(random.nextFloat());
+        processor->parameters.gainLFOAmountParam->setValueNotifyingHost(random.nextFloat());
+        processor->parameters.panLFOAmountParam->setValueNotifyingHost(random.nextFloat());
+        processor->parameters.gainLFOTypeParam->setValueNotifyingHost(random.nextFloat());
+
+        auto node = graph.addNode(std::move(processor));
+        processors.push_back(node->getProcessor());
+
+        for (int channel = 0; channel < 2; channel++) {
+            graph.addConnection({{input->nodeID, channel}, {node->nodeID, channel}});
+            graph.addConnection({{node->nodeID, channel}, {output->nodeID, channel}});
+        }
+    }
+
+    graph.prepareToPlay(sampleRate, blockSize);
+    auto memoryPerInstance = static_cast<double>(Benchmark::getResidentBytes() - memoryBefore) / numInstances;
+
+    AudioBuffer<float> source{2, blockSize};
+    AudioBuffer<float> buffer{2, blockSize};
+    MidiBuffer midi;
+
+    double serialCost = 0.0;
+    for (int block = 0; block < numBlocks; block++) {
+        Benchmark::fillWithNoise(source, random);
+        buffer.makeCopyOf(source, true);
+        serialCost += Benchmark::measureNanoseconds([&] { graph.processBlock(buffer, midi); });
+    }
+
+    ParallelBranchRenderer renderer{processors, numThreads, blockSize};
+    double parallelCost = 0.0;
+    double busyCost = 0.0;
+
+    for (int block = 0; block < numBlocks; block++) {
+        Benchmark::fillWithNoise(source, random);
+        parallelCost += Benchmark::measureNanoseconds([&] { busyCost += renderer.process(source, buffer); });
+    }
+
+    graph.releaseResources();
+
+    double blockBudget = 1.0e9 * blockSize / sampleRate;
+    double instanceSamples = static_cast<double>(numInstances) * blockSize * numBlocks;
+
+    std::cout << numInstances << " instances" << std::endl;
+    Benchmark::printRow("  serial graph wall/block", serialCost / numBlocks / 1000.0, "us");
+    Benchmark::printRow("  parallel wall/block", parallelCost / numBlocks / 1000.0, "us");
+    Benchmark::printRow("  parallel total CPU/block", busyCost / numBlocks / 1000.0, "us");
+    Benchmark::printRow("  parallel speedup", serialCost / parallelCost, "x");
+    Benchmark::printRow("  serial ns per instance-sample", serialCost / instanceSamples, "ns");
+    Benchmark::printRow("  parallel CPU per instance-sample", busyCost / instanceSamples, "ns");
+    Benchmark::printRow("  parallel realtime load", 100.0 * (parallelCost / numBlocks) / blockBudget, "%");
+    Benchmark::printRow("  memory per instance", memoryPerInstance / 1024.0, "KB");
+}
+
+auto GraphBenchmark::command() -> ConsoleApplication::Command {
+    return {
+        "graph",
+        "graph [--instances=1,64,256,1024] [--threads=N] [--block-size=256] [--blocks=500]",
+        "Measures how many parallel instances scale inside an AudioProcessorGraph",
+        "Builds a graph with N parallel Gain Booster branches and renders it serially through the graph and "
+        "concurrently with the branches split across a thread pool. The per instance-sample cost should stay "
+        "flat as N grows, a rising curve points at per-instance footprint or false sharing.",
+        [](const ArgumentList& args) {
+            auto instanceCounts = parseIntList(args.getValueForOption("--instances"));
+            if (instanceCounts.empty()) instanceCounts = {1, 64, 256, 1024};
+
+            int numThreads = jmax(1, Benchmark::getIntOption(args, "--threads", SystemStats::getNumCpus()));
+            int blockSize = Benchmark::getIntOption(args, "--block-size", 256);
+            int numBlocks = Benchmark::getIntOption(args, "--blocks", 500);
+            double sampleRate = 48000.0;
+
+            std::cout << "Threads: " << numThreads << ", block size: " << blockSize << std::endl;
+
+            for (auto numInstances : instanceCounts) {
+                runGraphBenchmark(numInstances, numThreads, blockSize, numBlocks, sampleRate);
+            }
+        }
+    };
+}
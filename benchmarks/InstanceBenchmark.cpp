@@ -0,0 +1,183 @@
+#include "Benchmark.hpp"
+#include "Processor.h"
+#include "Settings.hpp"
+#include <thread>
+
+// Hosts the value tree without any of the Processor members so each construction phase can be timed on its own
+class BareProcessor : public AudioProcessor {
+public:
+    BareProcessor() : AudioProcessor(BusesProperties()
+        .withInput("Input", AudioChannelSet::stereo(), true)
+        .withOutput("Output", AudioChannelSet::stereo(), true)) {}
+
+    auto prepareToPlay([[maybe_unused]] double sampleRate, [[maybe_unused]] int samplesPerBlock) -> void override {}
+    auto releaseResources() -> void override {}
+    auto processBlock([[maybe_unused]] AudioBuffer<float>& buffer, [[maybe_unused]] MidiBuffer& midi) -> void override {}
+
+    auto createEditor() -> AudioProcessorEditor* override { return nullptr; }
+    auto hasEditor() const -> bool override { return false; }
+    auto getName() const -> const String override { return JucePlugin_Name; }
+    auto acceptsMidi() const -> bool override { return false; }
+    auto producesMidi() const -> bool override { return false; }
+    auto getTailLengthSeconds() const -> double override { return 0.0; }
+
+    auto getNumPrograms() -> int override { return 1; }
+    auto getCurrentProgram() -> int override { return 0; }
+    auto setCurrentProgram([[maybe_unused]] int index) -> void override {}
+    auto getProgramName([[maybe_unused]] int index) -> const String override { return {}; }
+    auto changeProgramName([[maybe_unused]] int index, [[maybe_unused]] const String& newName) -> void override {}
+
+    auto getStateInformation([[maybe_unused]] MemoryBlock& destData) -> void override {}
+    auto setStateInformation([[maybe_unused]] const void* data, [[maybe_unused]] int sizeInBytes) -> void override {}
+
+    RealtimeLog realtimeLog;
+
+    AudioProcessorValueTreeState tree {
+        *this, nullptr, "Parameters", Parameters::createParameterLayout()
+    };
+};
+
+struct PhasedInstance {
+    std::unique_ptr<BareProcessor> processor;
+    std::unique_ptr<Parameters> parameters;
+    std::unique_ptr<PresetManager> presetManager;
+};
+
+struct Phase {
+    String name;
+    std::function<void(PhasedInstance&)> run;
+};
+
+static auto printInstanceRows(const String& label, double nanoseconds, int64 bytes, int accesses, int count) -> void {
+    Benchmark::printRow(label + " time", nanoseconds / count / 1000.0, "us");
+    Benchmark::printRow(label + " memory", static_cast<double>(bytes) / count / 1024.0, "KB");
+    Benchmark::printRow(label + " settings I/O", static_cast<double>(accesses) / count, "reads/writes");
+}
+
+static auto runPhaseBenchmark(int count) -> void {
+    std::vector<PhasedInstance> instances(static_cast<size_t>(count));
+
+    auto phases = std::vector<Phase>{
+        {"value tree", [](PhasedInstance& instance) {
+            instance.processor = std::make_unique<BareProcessor>();
+        }},
+        {"parameters", [](PhasedInstance& instance) {
+            instance.parameters = std::make_unique<Parameters>(instance.processor->tree, instance.processor->realtimeLog);
+        }},
+        {"preset manager", [](PhasedInstance& instance) {
+            instance.presetManager = std::make_unique<PresetManager>(instance.processor->tree);
+        }},
+        {"factory presets (on demand)", [](PhasedInstance& instance) {
+            instance.presetManager->ensureFactoryPresets();
+        }},
+        {"user presets (on demand)", [](PhasedInstance& instance) {
+            instance.presetManager->ensureUserPresets();
+        }},
+        {"destroy", [](PhasedInstance& instance) {
+            instance.presetManager.reset();
+            instance.parameters.reset();
+            instance.processor.reset();
+        }}
+    };
+
+    std::cout << "Phases (" << count << " instances, serial)" << std::endl;
+
+    for (auto& phase : phases) {
+        auto memoryBefore = Benchmark::getResidentBytes();
+        auto accessesBefore = Settings::fileAccesses.load();
+
+        double nanoseconds = Benchmark::measureNanoseconds([&] {
+            for (auto& instance : instances) phase.run(instance);
+        });
+
+        printInstanceRows("  " + phase.name, nanoseconds, Benchmark::getResidentBytes() - memoryBefore,
+            Settings::fileAccesses.load() - accessesBefore, count);
+    }
+}
+
+static auto runSerialBenchmark(int count) -> int {
+    std::vector<std::unique_ptr<Processor>> processors;
+    processors.reserve(static_cast<size_t>(count));
+
+    auto memoryBefore = Benchmark::getResidentBytes();
+    auto accessesBefore = Settings::fileAccesses.load();
+
+    double constructCost = Benchmark::measureNanoseconds([&] {
+        for (int i = 0; i < count; i++) processors.push_back(std::make_unique<Processor>());
+    });
+
+    auto memory = Benchmark::getResidentBytes() - memoryBefore;
+    auto accesses = Settings::fileAccesses.load() - accessesBefore;
+
+    double destroyCost = Benchmark::measureNanoseconds([&] {
+        processors.clear();
+    });
+
+    std::cout << "Processor (" << count << " instances, serial)" << std::endl;
+    printInstanceRows("  construct", constructCost, memory, accesses, count);
+    Benchmark::printRow("  destroy time", destroyCost / count / 1000.0, "us");
+
+    return accesses;
+}
+
+static auto runConcurrentBenchmark(int count, int numThreads) -> int {
+    std::vector<std::vector<std::unique_ptr<Processor>>> processors(static_cast<size_t>(numThreads));
+    std::vector<std::thread> threads;
+
+    auto memoryBefore = Benchmark::getResidentBytes();
+    auto accessesBefore = Settings::fileAccesses.load();
+
+    double constructCost = Benchmark::measureNanoseconds([&] {
+        for (int t = 0; t < numThreads; t++) {
+            int perThread = count / numThreads + (t < count % numThreads ? 1 : 0);
+
+            threads.emplace_back([&processors, t, perThread] {
+                auto& owned = processors[static_cast<size_t>(t)];
+                for (int i = 0; i < perThread; i++) owned.push_back(std::make_unique<Processor>());
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    });
+
+    auto memory = Benchmark::getResidentBytes() - memoryBefore;
+    auto accesses = Settings::fileAccesses.load() - accessesBefore;
+    threads.clear();
+
+    double destroyCost = Benchmark::measureNanoseconds([&] {
+        for (int t = 0; t < numThreads; t++) {
+            threads.emplace_back([&processors, t] { processors[static_cast<size_t>(t)].clear(); });
+        }
+        for (auto& thread : threads) thread.join();
+    });
+
+    std::cout << "Processor (" << count << " instances, " << numThreads << " threads)" << std::endl;
+    printInstanceRows("  construct (wall)", constructCost, memory, accesses, count);
+    Benchmark::printRow("  destroy time (wall)", destroyCost / count / 1000.0, "us");
+
+    return accesses;
+}
+
+auto InstanceBenchmark::command() -> ConsoleApplication::Command {
+    return {
+        "instances",
+        "instances [--count=64] [--threads=4]",
+        "Measures Processor construction and destruction cost",
+        "Constructs and destroys N processors serially and concurrently, reporting time, resident memory and "
+        "settings.json accesses per instance. Phases break the serial cost down into the value tree, parameter "
+        "binding, preset manager and the on demand preset loads. A scan-only instantiation should do no file I/O.",
+        [](const ArgumentList& args) {
+            int count = jmax(1, Benchmark::getIntOption(args, "--count", 64));
+            int numThreads = jmax(1, Benchmark::getIntOption(args, "--threads", 4));
+
+            runPhaseBenchmark(count);
+            int serialAccesses = runSerialBenchmark(count);
+            int concurrentAccesses = runConcurrentBenchmark(count, numThreads);
+
+            Benchmark::printRow("peak resident memory", static_cast<double>(Benchmark::getPeakResidentBytes()) / (1024.0 * 1024.0), "MB");
+
+            bool scanIsFileFree = serialAccesses == 0 && concurrentAccesses == 0;
+            std::cout << "Goal: no file I/O during scan-only instantiation - " << (scanIsFileFree ? "met" : "NOT met") << std::endl;
+            if (!scanIsFileFree) ConsoleApplication::fail("Processor construction touched settings.json");
+        }
+    };
+}
@@ -0,0 +1,147 @@
+#include "Benchmark.hpp"
+#include "Processor.h"
+
+static auto prepareProcessor(Processor& processor, int blockSize, double sampleRate) -> void {
+    processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    processor.parameters.gainLFOAmountParam->setValueNotifyingHost(1.0f);
+    processor.parameters.panLFOAmountParam->setValueNotifyingHost(0.5f);
+    processor.parameters.boostParam->setValueNotifyingHost(0.5f);
+}
+
+static auto getFrameBytes(PCMFormat format) -> int {
+    switch (format) {
+        case PCMFormat::float32: return 8;
+        case PCMFormat::int16: return 4;
+        case PCMFormat::int24: return 6;
+    }
+    return 8;
+}
+
+static auto getFormatName(PCMFormat format) -> String {
+    switch (format) {
+        case PCMFormat::float32: return "float32";
+        case PCMFormat::int16: return "int16";
+        case PCMFormat::int24: return "int24";
+    }
+    return {};
+}
+
+static auto readSample(const uint8_t* frames, PCMFormat format, int index) -> float {
+    switch (format) {
+        case PCMFormat::float32: return reinterpret_cast<const float*>(frames)[index];
+        case PCMFormat::int16: return reinterpret_cast<const int16_t*>(frames)[index] / 32768.0f;
+        case PCMFormat::int24: {
+            auto* bytes = frames + 3 * index;
+            auto bits = static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16);
+            return static_cast<float>(static_cast<int32_t>(bits << 8) >> 8) / 8388608.0f;
+        }
+    }
+    return 0.0f;
+}
+
+static auto writeSample(uint8_t* frames, PCMFormat format, int index, float value) -> void {
+    switch (format) {
+        case PCMFormat::float32: {
+            reinterpret_cast<float*>(frames)[index] = value;
+            break;
+        }
+        case PCMFormat::int16: {
+            reinterpret_cast<int16_t*>(frames)[index] = static_cast<int16_t>(roundToInt(jlimit(-32768.0f, 32767.0f, value * 32768.0f)));
+            break;
+        }
+        case PCMFormat::int24: {
+            auto bits = static_cast<uint32_t>(roundToInt(jlimit(-8388608.0f, 8388607.0f, value * 8388608.0f)));
+            auto* bytes = frames + 3 * index;
+            bytes[0] = static_cast<uint8_t>(bits);
+            bytes[1] = static_cast<uint8_t>(bits >> 8);
+            bytes[2] = static_cast<uint8_t>(bits >> 16);
+            break;
+        }
+    }
+}
+
+static auto fillFrames(std::vector<uint8_t>& frames, PCMFormat format, int numFrames, Random& random) -> void {
+    for (int index = 0; index < numFrames * 2; index++) {
+        writeSample(frames.data(), format, index, (random.nextFloat() * 2.0f - 1.0f) * 0.5f);
+    }
+}
+
+// The ingest path this entry point replaces: deinterleave and convert, processBlock, convert and reinterleave
+static auto runDeinterleavedBenchmark(PCMFormat format, int blockSize, int numBlocks, double sampleRate) -> double {
+    Processor processor;
+    prepareProcessor(processor, blockSize, sampleRate);
+
+    std::vector<uint8_t> frames(static_cast<size_t>(blockSize * getFrameBytes(format)));
+    AudioBuffer<float> buffer{2, blockSize};
+    MidiBuffer midi;
+    Random random{1234};
+    double totalNanoseconds = 0.0;
+
+    for (int block = 0; block < numBlocks; block++) {
+        fillFrames(frames, format, blockSize, random);
+
+        totalNanoseconds += Benchmark::measureNanoseconds([&] {
+            for (int frame = 0; frame < blockSize; frame++) {
+                buffer.setSample(0, frame, readSample(frames.data(), format, 2 * frame));
+                buffer.setSample(1, frame, readSample(frames.data(), format, 2 * frame + 1));
+            }
+
+            processor.processBlock(buffer, midi);
+
+            for (int frame = 0; frame < blockSize; frame++) {
+                writeSample(frames.data(), format, 2 * frame, buffer.getSample(0, frame));
+                writeSample(frames.data(), format, 2 * frame + 1, buffer.getSample(1, frame));
+            }
+        });
+    }
+
+    return totalNanoseconds / (static_cast<double>(blockSize) * numBlocks);
+}
+
+static auto runInterleavedBenchmark(PCMFormat format, int blockSize, int numBlocks, double sampleRate) -> double {
+    Processor processor;
+    prepareProcessor(processor, blockSize, sampleRate);
+
+    std::vector<uint8_t> frames(static_cast<size_t>(blockSize * getFrameBytes(format)));
+    Random random{1234};
+    double totalNanoseconds = 0.0;
+
+    for (int block = 0; block < numBlocks; block++) {
+        fillFrames(frames, format, blockSize, random);
+
+        totalNanoseconds += Benchmark::measureNanoseconds([&] {
+            processor.processInterleaved(frames.data(), format, blockSize);
+        });
+    }
+
+    return totalNanoseconds / (static_cast<double>(blockSize) * numBlocks);
+}
+
+auto InterleavedBenchmark::command() -> ConsoleApplication::Command {
+    return {
+        "interleaved",
+        "interleaved [--block-size=512] [--blocks=20000]",
+        "Compares processInterleaved against deinterleaving around processBlock",
+        "Runs float32, int16 and int24 interleaved stereo through the in-place entry point and through a "
+        "deinterleave, processBlock and reinterleave round trip, reporting the cost per frame.",
+        [](const ArgumentList& args) {
+            int blockSize = Benchmark::getIntOption(args, "--block-size", 512);
+            int numBlocks = Benchmark::getIntOption(args, "--blocks", 20000);
+            double sampleRate = 48000.0;
+
+            std::cout << "Selected kernels: " << Kernels::getISAName(Kernels::detectISA()) << std::endl;
+
+            for (auto format : {PCMFormat::float32, PCMFormat::int16, PCMFormat::int24}) {
+                double roundTripCost = runDeinterleavedBenchmark(format, blockSize, numBlocks, sampleRate);
+                double inPlaceCost = runInterleavedBenchmark(format, blockSize, numBlocks, sampleRate);
+
+                std::cout << getFormatName(format) << std::endl;
+                Benchmark::printRow("  round trip ns/frame", roundTripCost, "ns");
+                Benchmark::printRow("  in place ns/frame", inPlaceCost, "ns");
+                Benchmark::printRow("  speedup", roundTripCost / inPlaceCost, "x");
+            }
+        }
+    };
+}
@@ -0,0 +1,67 @@
+#include "Benchmark.hpp"
+#include "Kernels.h"
+
+template <typename SampleType>
+static auto runKernelBenchmark(const KernelTable<SampleType>& kernels, int blockSize, int numBlocks) -> void {
+    AudioBuffer<SampleType> input{2, blockSize};
+    AudioBuffer<SampleType> output{2, blockSize};
+    AudioBuffer<SampleType> modulation{3, blockSize};
+    Random random{1234};
+
+    Benchmark::fillWithNoise(input, random);
+    Benchmark::fillWithNoise(modulation, random);
+
+    auto samples = static_cast<double>(blockSize) * numBlocks;
+    SampleType phase = SampleType(0);
+    SampleType peak = SampleType(0);
+
+    double gainPanCost = Benchmark::measureNanoseconds([&] {
+        for (int block = 0; block < numBlocks; block++) {
+            kernels.applyGainPan(input.getReadPointer(0), input.getReadPointer(1), output.getWritePointer(0), 
+                output.getWritePointer(1), modulation.getReadPointer(0), modulation.getReadPointer(1), 
+                modulation.getReadPointer(2), blockSize);
+        }
+    });
+
+    double lfoCost = Benchmark::measureNanoseconds([&] {
+        for (int block = 0; block < numBlocks; block++) {
+            phase = kernels.renderLFO(output.getWritePointer(0), phase, SampleType(0.0001), 
+                LFOShape::triangle, true, blockSize);
+        }
+    });
+
+    double meterCost = Benchmark::measureNanoseconds([&] {
+        for (int block = 0; block < numBlocks; block++) {
+            peak = jmax(peak, kernels.measureBlock(input.getReadPointer(0), blockSize, SampleType(2)).peak);
+        }
+    });
+
+    Benchmark::printRow("  applyGainPan ns/sample", gainPanCost / samples, "ns");
+    Benchmark::printRow("  renderLFO ns/sample", lfoCost / samples, "ns");
+    Benchmark::printRow("  measureBlock ns/sample", meterCost / samples, "ns");
+}
+
+auto KernelBenchmark::command() -> ConsoleApplication::Command {
+    return {
+        "kernels",
+        "kernels [--block-size=512] [--blocks=20000]",
+        "Times every SIMD kernel path supported by this CPU",
+        "Runs the gain/pan, LFO and metering kernels for each instruction set and reports which one is selected.",
+        [](const ArgumentList& args) {
+            int blockSize = Benchmark::getIntOption(args, "--block-size", 512);
+            int numBlocks = Benchmark::getIntOption(args, "--blocks", 20000);
+
+            std::cout << "Selected kernels: " << Kernels::getISAName(Kernels::detectISA()) << std::endl;
+
+            for (auto isa : {KernelISA::scalar, KernelISA::sse2, KernelISA::avx2, KernelISA::avx512, KernelISA::neon}) {
+                if (!Kernels::isSupported(isa)) continue;
+
+                std::cout << Kernels::getISAName(isa) << " float" << std::endl;
+                runKernelBenchmark(Kernels::getTable<float>(isa), blockSize, numBlocks);
+
+                std::cout << Kernels::getISAName(isa) << " double" << std::endl;
+                runKernelBenchmark(Kernels::getTable<double>(isa), blockSize, numBlocks);
+            }
+        }
+    };
+}
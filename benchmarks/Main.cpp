@@ -0,0 +1,19 @@
+#include <JuceHeader.h>
+#include "Benchmark.hpp"
+
+auto main(int argc, char* argv[]) -> int {
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "Gain Booster Benchmarks", true);
+    app.addCommand(ProcessBenchmark::command());
+    app.addCommand(KernelBenchmark::command());
+    app.addCommand(InstanceBenchmark::command());
+    app.addCommand(GraphBenchmark::command());
+    app.addCommand(InterleavedBenchmark::command());
+    app.addCommand(PresetBenchmark::command());
+    app.addCommand(SearchBenchmark::command());
+    app.addCommand(AudioRateBenchmark::command());
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,87 @@
+#include "Benchmark.hpp"
+#include "Processor.h"
+#include "PresetParser.hpp"
+
+// The read side of the previous loadPreset: a full var/DynamicObject tree for a handful of fields
+static auto readWithJUCE(const String& json) -> int {
+    auto parsed = JSON::fromString(json);
+    auto* obj = parsed.getDynamicObject();
+    if (obj == nullptr) return 0;
+
+    auto name = obj->getProperty("name").toString();
+    auto* parameters = obj->getProperty("parameters").getDynamicObject();
+    if (parameters == nullptr) return 0;
+
+    int length = name.length();
+    for (const auto& property : parameters->getProperties()) {
+        length += property.value.toString().length();
+    }
+    return length;
+}
+
+static auto readWithParser(const String& json, ParsedPreset& preset) -> int {
+    if (!PresetParser::parse(json, preset)) return 0;
+
+    auto length = static_cast<int>(preset.name.length);
+    for (size_t index = 0; index < PresetSchema::instance().numParameters; index++) {
+        if (preset.present[index]) length += static_cast<int>(preset.values[index].length);
+    }
+    return length;
+}
+
+auto PresetBenchmark::command() -> ConsoleApplication::Command {
+    return {
+        "presets",
+        "presets [--iterations=200]",
+        "Compares the preset parser against juce::JSON",
+        "Parses every factory preset with juce::JSON (the previous loadPreset path) and with PresetParser, "
+        "then times loadPreset and a factory preset scan end to end.",
+        [](const ArgumentList& args) {
+            int iterations = jmax(1, Benchmark::getIntOption(args, "--iterations", 200));
+
+            Processor processor;
+            auto& presetManager = processor.presetManager;
+            presetManager.ensureFactoryPresets();
+
+            std::vector<String> presets;
+            for (const auto& name : presetManager.factoryPresetNames) presets.push_back(presetManager.factoryPresets[name]);
+            if (presets.empty()) ConsoleApplication::fail("No factory presets to parse");
+
+            auto numParses = static_cast<double>(presets.size()) * iterations;
+            ParsedPreset parsed;
+            int checksum = 0;
+
+            double juceCost = Benchmark::measureNanoseconds([&] {
+                for (int i = 0; i < iterations; i++) {
+                    for (const auto& json : presets) checksum += readWithJUCE(json);
+                }
+            });
+
+            double parserCost = Benchmark::measureNanoseconds([&] {
+                for (int i = 0; i < iterations; i++) {
+                    for (const auto& json : presets) checksum -= readWithParser(json, parsed);
+                }
+            });
+
+            if (checksum != 0) ConsoleApplication::fail("The parsers disagree on the preset contents");
+
+            double loadCost = Benchmark::measureNanoseconds([&] {
+                for (int i = 0; i < iterations; i++) {
+                    for (const auto& json : presets) presetManager.loadPreset(json);
+                }
+            });
+
+            int scans = jmax(1, iterations / 10);
+            double scanCost = Benchmark::measureNanoseconds([&] {
+                for (int i = 0; i < scans; i++) presetManager.loadFactoryPresets();
+            });
+
+            std::cout << presets.size() << " factory presets" << std::endl;
+            Benchmark::printRow("juce::JSON parse", juceCost / numParses / 1000.0, "us");
+            Benchmark::printRow("PresetParser parse", parserCost / numParses / 1000.0, "us");
+            Benchmark::printRow("parse speedup", juceCost / parserCost, "x");
+            Benchmark::printRow("loadPreset (parse + apply)", loadCost / numParses / 1000.0, "us");
+            Benchmark::printRow("factory scan", scanCost / scans / 1000.0, "us");
+        }
+    };
+}
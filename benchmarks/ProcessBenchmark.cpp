@@ -0,0 +1,56 @@
+#include "Benchmark.hpp"
+#include "Processor.h"
+
+template <typename SampleType>
+static auto runProcessBenchmark(int blockSize, int numBlocks, double sampleRate) -> double {
+    Processor processor;
+    processor.setProcessingPrecision(std::is_same_v<SampleType, double> 
+        ? AudioProcessor::doublePrecision : AudioProcessor::singlePrecision);
+    processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    processor.parameters.gainLFOAmountParam->setValueNotifyingHost(1.0f);
+    processor.parameters.panLFOAmountParam->setValueNotifyingHost(0.5f);
+    processor.parameters.boostParam->setValueNotifyingHost(0.5f);
+
+    AudioBuffer<SampleType> buffer{2, blockSize};
+    MidiBuffer midi;
+    Random random{1234};
+
+    double totalNanoseconds = 0.0;
+
+    for (int block = 0; block < numBlocks; block++) {
+        Benchmark::fillWithNoise(buffer, random);
+        totalNanoseconds += Benchmark::measureNanoseconds([&] {
+            processor.processBlock(buffer, midi);
+        });
+    }
+
+    processor.releaseResources();
+    return totalNanoseconds / (static_cast<double>(blockSize) * numBlocks);
+}
+
+auto ProcessBenchmark::command() -> ConsoleApplication::Command {
+    return {
+        "process",
+        "process [--block-size=512] [--blocks=20000]",
+        "Compares the float and double processBlock paths",
+        "Runs the same automated LFO settings through both precisions and reports the cost per sample.",
+        [](const ArgumentList& args) {
+            int blockSize = Benchmark::getIntOption(args, "--block-size", 512);
+            int numBlocks = Benchmark::getIntOption(args, "--blocks", 20000);
+            double sampleRate = 48000.0;
+
+            double floatCost = runProcessBenchmark<float>(blockSize, numBlocks, sampleRate);
+            double doubleCost = runProcessBenchmark<double>(blockSize, numBlocks, sampleRate);
+            double realtimeBudget = 1.0e9 / sampleRate;
+
+            std::cout << "Selected kernels: " << Kernels::getISAName(Kernels::detectISA()) << std::endl;
+            Benchmark::printRow("float ns/sample", floatCost, "ns");
+            Benchmark::printRow("double ns/sample", doubleCost, "ns");
+            Benchmark::printRow("double/float ratio", doubleCost / floatCost, "x");
+            Benchmark::printRow("float realtime load", 100.0 * floatCost / realtimeBudget, "%");
+            Benchmark::printRow("double realtime load", 100.0 * doubleCost / realtimeBudget, "%");
+        }
+    };
+}
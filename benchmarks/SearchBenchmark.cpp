@@ -0,0 +1,59 @@
+#include "Benchmark.hpp"
+#include "PresetSearchIndex.h"
+
+static auto makeLibrary(int numPresets, Random& random) -> std::vector<std::pair<String, String>> {
+    static const StringArray words{"Dubstep", "Wobble", "Bass", "Lead", "Pad", "Soft", "Pump", "Sidechain", "Tremolo", 
+        "Wide", "Stereo", "Gate", "Trance", "Chop", "Pluck", "Ambient", "Sweep", "Slow", "Fast", "Half", "Vocal", 
+        "Drum", "Bounce", "Glide", "Ping", "Pong", "Swell", "Throb", "Pulse", "Drift", "Motion", "Shimmer"};
+    static const StringArray authors{"Moebytes", "Factory", "Studio", "Guest Artist", "Sound Design Team"};
+
+    std::vector<std::pair<String, String>> library;
+    library.reserve(static_cast<size_t>(numPresets));
+
+    for (int i = 0; i < numPresets; i++) {
+        StringArray name;
+        for (int word = 0, count = 2 + random.nextInt(3); word < count; word++) {
+            name.add(words[random.nextInt(words.size())]);
+        }
+        name.add(String(i));
+        library.emplace_back(name.joinIntoString(" "), authors[random.nextInt(authors.size())]);
+    }
+    return library;
+}
+
+auto SearchBenchmark::command() -> ConsoleApplication::Command {
+    return {
+        "search",
+        "search [--presets=50000] [--iterations=200]",
+        "Times the preset search index",
+        "Builds the trigram index over a synthetic library and times ranked queries of the kind "
+        "PresetBar sends on each keystroke, from single letters to misspelt multi word queries.",
+        [](const ArgumentList& args) {
+            int numPresets = jmax(1, Benchmark::getIntOption(args, "--presets", 50000));
+            int iterations = jmax(1, Benchmark::getIntOption(args, "--iterations", 200));
+
+            Random random{42};
+            auto library = makeLibrary(numPresets, random);
+            PresetSearchIndex index;
+
+            double buildCost = Benchmark::measureNanoseconds([&] {
+                index.clear();
+                for (const auto& [name, author] : library) index.add(name.toRawUTF8(), author.toRawUTF8());
+                index.finalise();
+            });
+
+            std::cout << numPresets << " presets" << std::endl;
+            Benchmark::printRow("index build", buildCost / 1e6, "ms");
+
+            size_t checksum = 0;
+            for (const auto* query : {"d", "du", "dub", "dubstep", "dubstap", "wob ba", "moebytes", "sidechain pump", "12345"}) {
+                double cost = Benchmark::measureNanoseconds([&] {
+                    for (int i = 0; i < iterations; i++) checksum += index.search(query, 20).size();
+                });
+                Benchmark::printRow("search \"" + String(query) + "\"", cost / iterations / 1000.0, "us");
+            }
+
+            if (checksum == 0) ConsoleApplication::fail("No search returned any results");
+        }
+    };
+}
@@ -0,0 +1,52 @@
+import React, {useState, useEffect} from "react"
+import * as JUCE from "juce-framework-frontend-mirror"
+import "./styles/cpumeter.scss"
+
+const getPerformanceStats = JUCE.getNativeFunction("getPerformanceStats")
+
+interface PerformanceStats {
+    blocks: number
+    samples: number
+    lastNsPerSample: number
+    averageNsPerSample: number
+    maxNsPerSample: number
+    p50NsPerSample: number
+    p90NsPerSample: number
+    p99NsPerSample: number
+    cpuLoad: number
+    nonFiniteSamples: number
+    outOfRangeSamples: number
+    repairedBlocks: number
+}
+
+const CPUMeter: React.FunctionComponent = () => {
+    const [stats, setStats] = useState(null as PerformanceStats | null)
+
+    useEffect(() => {
+        const update = async () => {
+            const result = await getPerformanceStats()
+            if (result) setStats(result)
+        }
+        update()
+        const interval = window.setInterval(update, 500)
+        return () => window.clearInterval(interval)
+    }, [])
+
+    if (!stats) return null
+
+    const percent = (stats.cpuLoad * 100).toFixed(1)
+    const title = `avg ${stats.averageNsPerSample.toFixed(1)} ns/sample\n` +
+    `p50 ${stats.p50NsPerSample.toFixed(1)} / p90 ${stats.p90NsPerSample.toFixed(1)} / p99 ${stats.p99NsPerSample.toFixed(1)} ns\n` +
+    `max ${stats.maxNsPerSample.toFixed(1)} ns/sample\n` +
+    `repaired ${stats.repairedBlocks} blocks (${stats.nonFiniteSamples} non-finite), ${stats.outOfRangeSamples} samples over +12 dBFS`
+
+    return (
+        <div className="cpu-meter" title={title}>
+            <span className="cpu-meter-label">CPU</span>
+            <span className="cpu-meter-value">{percent}%</span>
+            <span className="cpu-meter-detail">{stats.lastNsPerSample.toFixed(1)} ns</span>
+        </div>
+    )
+}
+
+export default CPUMeter
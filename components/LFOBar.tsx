@@ -3,6 +3,8 @@ import {ThemeContext} from "../index"
 import withJuceSlider, {WithJUCESliderProps} from "./withJuceSlider"
 import withJuceComboBox, {WithJUCEComboBoxProps} from "./withJuceComboBox"
 import MiniKnob from "./MiniKnob"
+import ModulationScope from "./ModulationScope"
+import {ModulationTarget} from "../structures/ModulationStream"
 import functions from "../structures/Functions"
 import squareWave from "../assets/square-wave.png"
 import sineWave from "../assets/sine-wave.png"
@@ -157,6 +159,7 @@ interface Props {
     lfoTypeID: string
     lfoRateID: string
     lfoAmountID: string
+    target: ModulationTarget
     label: string
     color: string
     style?: React.CSSProperties
@@ -165,10 +168,11 @@ interface Props {
 const LFOBarTypeCombo = withJuceComboBox(LFOBarType)
 const LFOBarRateSlider = withJuceSlider(LFOBarRate)
 
-const LFOBar: React.FunctionComponent<Props> = ({lfoTypeID, lfoRateID, lfoAmountID, label, color}) => {
+const LFOBar: React.FunctionComponent<Props> = ({lfoTypeID, lfoRateID, lfoAmountID, target, label, color}) => {
     return (
         <div className="lfobar-container">
             <LFOBarTypeCombo parameterID={lfoTypeID} color={color} label={label}/>
+            <ModulationScope target={target} color={color}/>
             <LFOBarRateSlider parameterID={lfoRateID} color={color}/>
             <MiniKnob parameterID={lfoAmountID} color={color} label={label}/>
         </div>
@@ -0,0 +1,53 @@
+import React, {useEffect, useRef} from "react"
+import modulationStream, {ModulationTarget} from "../structures/ModulationStream"
+
+interface Props {
+    target: ModulationTarget
+    color: string
+}
+
+const ModulationScope: React.FunctionComponent<Props> = ({target, color}) => {
+    const canvasRef = useRef<HTMLCanvasElement>(null)
+
+    useEffect(() => {
+        let frame = 0
+
+        const draw = () => {
+            frame = 0
+            const canvas = canvasRef.current
+            const context = canvas?.getContext("2d")
+            if (!canvas || !context) return
+
+            const {width, height} = canvas
+            const history = modulationStream.getHistory(target)
+            const length = modulationStream.length
+            // Gain spans 0 to 1 with boost clipped at the top, pan spans -1 (bottom) to 1 (top)
+            const toY = (value: number) => target === "gain" ? 
+                height * (1 - Math.min(1, value)) : height * (1 - (value + 1) / 2)
+
+            context.clearRect(0, 0, width, height)
+            context.fillStyle = color
+            for (let x = 0; x < width; x++) {
+                const index = (history.head + Math.floor(x * length / width)) % length
+                const top = toY(history.max[index])
+                const bottom = toY(history.min[index])
+                context.fillRect(x, top, 1, Math.max(1, bottom - top))
+            }
+
+            context.fillRect(history.phase * width, height - 2, 2, 2)
+        }
+
+        // Events arrive at most at the editor's capped rate, drawing waits for the next frame
+        const unsubscribe = modulationStream.subscribe(() => {
+            if (!frame) frame = requestAnimationFrame(draw)
+        })
+        return () => {
+            unsubscribe()
+            if (frame) cancelAnimationFrame(frame)
+        }
+    }, [target, color])
+
+    return <canvas className="lfobar-scope" ref={canvasRef} width={96} height={28}/>
+}
+
+export default ModulationScope
\ No newline at end of file
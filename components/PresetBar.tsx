@@ -1,4 +1,4 @@
-import React, {useState, useEffect} from "react"
+import React, {useState, useEffect, useRef} from "react"
 import * as JUCE from "juce-framework-frontend-mirror"
 import "./styles/presetbar.scss"
 
@@ -6,13 +6,27 @@ const openPresetMenu = JUCE.getNativeFunction("openPresetMenu")
 const prevPreset = JUCE.getNativeFunction("prevPreset")
 const nextPreset = JUCE.getNativeFunction("nextPreset")
 const currentPresetName = JUCE.getNativeFunction("currentPresetName")
+const searchPresets = JUCE.getNativeFunction("searchPresets")
+const selectPreset = JUCE.getNativeFunction("selectPreset")
+
+interface SearchResult {
+    name: string
+    author: string
+    folder: "factory" | "user"
+    index: number
+}
 
 
 const PresetBar: React.FunctionComponent = () => {
     const [preset, setPreset] = useState("Default")
+    const [searching, setSearching] = useState(false)
+    const [query, setQuery] = useState("")
+    const [results, setResults] = useState([] as SearchResult[])
+    const searchID = useRef(0)
 
     useEffect(() => {
         window.__JUCE__.backend.addEventListener("presetChanged", changePreset)
+        window.__JUCE__.backend.addEventListener("editorAttached", current)
         current()
     }, [])
 
@@ -40,16 +54,62 @@ const PresetBar: React.FunctionComponent = () => {
         setPreset(name)
     }
 
+    const search = async (text: string) => {
+        setQuery(text)
+        const id = ++searchID.current
+        const found = text.trim() ? await searchPresets(text, 20) : []
+        // Keystrokes can outrun replies, only the newest query may update the list
+        if (id === searchID.current) setResults(found ?? [])
+    }
+
+    const closeSearch = () => {
+        searchID.current++
+        setSearching(false)
+        setQuery("")
+        setResults([])
+    }
+
+    const choose = async (result: SearchResult) => {
+        closeSearch()
+        const name = await selectPreset(result.folder, result.index)
+        if (name) setPreset(name)
+    }
+
+    const searchKeyDown = (event: React.KeyboardEvent) => {
+        if (event.key === "Escape") closeSearch()
+        if (event.key === "Enter" && results.length) choose(results[0])
+    }
+
     const shapes = {
         leftArrow: <polygon points="15,6 9,12 15,18" fill="currentColor"/>,
-        rightArrow: <polygon points="9,6 15,12 9,18" fill="currentColor"/>
+        rightArrow: <polygon points="9,6 15,12 9,18" fill="currentColor"/>,
+        search: <path d="M10 4a6 6 0 1 0 3.6 10.8l4.3 4.3 1.4-1.4-4.3-4.3A6 6 0 0 0 10 4zm0 2a4 4 0 1 1 0 8 4 4 0 0 1 0-8z" fill="currentColor"/>
+    }
+
+    const resultsJSX = () => {
+        return results.map((result) => (
+            <div key={`${result.folder}-${result.index}`} className="preset-search-result" onMouseDown={() => choose(result)}>
+                <span className="preset-search-result-name">{result.name}</span>
+                {result.author ? <span className="preset-search-result-author">{result.author}</span> : null}
+            </div>
+        ))
     }
 
     return (
         <div className="preset-bar">
             <span className="preset-title">Preset:</span>
-            <span className="preset-name" onClick={presetMenu}>{preset}</span>
+            {searching ? 
+            <div className="preset-search">
+                <input className="preset-search-input" autoFocus spellCheck={false} value={query} placeholder={preset}
+                    onChange={(event) => search(event.target.value)} onKeyDown={searchKeyDown} onBlur={closeSearch}/>
+                {results.length ? <div className="preset-search-results">{resultsJSX()}</div> : null}
+            </div> :
+            <span className="preset-name" onClick={presetMenu}>{preset}</span>}
             <div className="preset-arrows">
+                <svg className="preset-search-icon" onClick={() => searching ? closeSearch() : setSearching(true)} 
+                    xmlns="http://www.w3.org/2000/svg" viewBox="0 0 24 24">
+                    {shapes.search}
+                </svg>
                 <svg className="preset-left-arrow" onClick={prev} xmlns="http://www.w3.org/2000/svg" viewBox="0 0 24 24">
                     {shapes.leftArrow}
                 </svg>
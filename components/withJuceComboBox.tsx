@@ -1,10 +1,9 @@
 import React, {useEffect, useState} from "react"
-import * as JUCE from "juce-framework-frontend-mirror"
+import parameterStore from "../structures/ParameterStore"
 
 interface JUCEComboProperties {
-    name: string
-    parameterIndex: number
     choices: string[]
+    defaultValue: number
 }
 
 export interface WithJUCEComboBoxProps {
@@ -18,45 +17,34 @@ interface WithParameter {
     parameterID: string
 }
 
-const getDefaultParameter = JUCE.getNativeFunction("getDefaultParameter")
-
 const withJuceComboBox = <Props extends object & WithParameter>(
     WrappedComponent: React.ComponentType<Props & WithJUCEComboBoxProps>, 
 ): React.FunctionComponent<Props> => {
 
         const JuceComboBox: React.FunctionComponent<Props> = (props) => {
             const {parameterID} = props
-            const comboState = JUCE.getComboBoxState(parameterID)!
-            const [properties, setProperties] = useState(comboState.properties)
-            const [value, setValue] = useState(comboState.getChoiceIndex())
+            const [properties, setProperties] = useState(parameterStore.getSlot(parameterID))
+            const [value, setValue] = useState(properties?.value ?? 0)
 
             useEffect(() => {
-                setValue(comboState.getChoiceIndex())
-                setProperties(comboState.properties)
-            }, [])
-        
-            useEffect(() => {
-                const valueID = comboState.valueChangedEvent.addListener(() => {
-                    setValue(comboState.getChoiceIndex())
-                })
-                const propsID = comboState.propertiesChangedEvent.addListener(() => {
-                    setProperties(comboState.properties)
+                const unsubscribe = parameterStore.subscribe(parameterID, (slot) => {
+                    setProperties(slot)
+                    setValue(slot.value)
                 })
-                return () => {
-                    comboState.valueChangedEvent.removeListener(valueID)
-                    comboState.propertiesChangedEvent.removeListener(propsID)
-                }
+                parameterStore.load()
+                return unsubscribe
             }, [])
         
             const handleChange = (index: number) => {
-                comboState.setChoiceIndex(index)
+                parameterStore.setValue(parameterID, index)
                 setValue(index)
             }
         
-            const handleReset = async () => {
-                const defaultValue = await getDefaultParameter(parameterID)
-                handleChange(defaultValue)
+            const handleReset = () => {
+                if (properties) handleChange(properties.defaultValue)
             }
+
+            if (!properties) return null
         
             return (
                 <WrappedComponent
@@ -1,16 +1,11 @@
 import React, {useEffect, useState} from "react"
-import * as JUCE from "juce-framework-frontend-mirror"
-import functions from "../structures/Functions"
+import parameterStore from "../structures/ParameterStore"
 
 interface JUCESliderProperties {
     start: number
     end: number
-    skew: number
-    name: string
-    label: string
     numSteps: number
-    interval: number
-    parameterIndex: number
+    defaultValue: number
 }
 
 export interface WithJUCESliderProps {
@@ -26,55 +21,41 @@ interface WithParameter {
     parameterID: string
 }
 
-const getDefaultParameter = JUCE.getNativeFunction("getDefaultParameter")
-
 const withJuceSlider = <Props extends object & WithParameter>(
     WrappedComponent: React.ComponentType<Props & WithJUCESliderProps>, 
 ): React.FunctionComponent<Props> => {
 
     const JuceSlider: React.FunctionComponent<Props> = (props) => {
         const {parameterID} = props
-        const sliderState = JUCE.getSliderState(parameterID)!
-        const [properties, setProperties] = useState(sliderState.properties)
-        const [value, setValue] = useState(sliderState.getScaledValue())
+        const [properties, setProperties] = useState(parameterStore.getSlot(parameterID))
+        const [value, setValue] = useState(properties?.value ?? 0)
         const [dragging, setDragging] = useState(false)
 
         useEffect(() => {
-            setValue(sliderState.getScaledValue())
-            setProperties(sliderState.properties)
-        }, [])
-    
-        useEffect(() => {
-            const valueID = sliderState.valueChangedEvent.addListener(() => {
-                setValue(sliderState.getScaledValue())
+            const unsubscribe = parameterStore.subscribe(parameterID, (slot) => {
+                setProperties(slot)
+                setValue(slot.value)
             })
-            const propsID = sliderState.propertiesChangedEvent.addListener(() => {
-                setProperties(sliderState.properties)
-            })
-            return () => {
-                sliderState.valueChangedEvent.removeListener(valueID)
-                sliderState.propertiesChangedEvent.removeListener(propsID)
-            }
+            parameterStore.load()
+            return unsubscribe
         }, [])
     
         const handleChange = (value: number) => {
-            const normalized = functions.normalizeRange(value, properties.start, properties.end)
-            sliderState.setNormalisedValue(normalized)
+            parameterStore.setValue(parameterID, value)
             setValue(value)
         }
     
-        const handleReset = async () => {
-            const defaultValue = await getDefaultParameter(parameterID)
-            handleChange(defaultValue)
+        const handleReset = () => {
+            if (properties) handleChange(properties.defaultValue)
         }
     
         const handleDragStart = () => {
-            sliderState.sliderDragStarted()
+            parameterStore.beginGesture(parameterID)
             setDragging(true)
         }
     
         const handleDragEnd = () => {
-            sliderState.sliderDragEnded()
+            parameterStore.endGesture(parameterID)
             setDragging(false)
         }
     
@@ -87,6 +68,8 @@ const withJuceSlider = <Props extends object & WithParameter>(
                 document.removeEventListener("mouseup", handleMouseUp)
             }
         }, [dragging])
+
+        if (!properties) return null
     
         return (
             <WrappedComponent
@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Kernels.h"
+
+/*
+ * Sidechain detector for ducking. Each block is split into segments of segmentLength samples, one
+ * kernel pass rectifies both sidechain channels into per-segment peaks, the attack/release smoothing
+ * runs once per segment and the resulting duck gain is ramped linearly across each segment by a
+ * second kernel pass. With no sidechain or a zero amount nothing runs, and a silent sidechain
+ * only costs the peak pass once the envelope has released.
+ */
+template <typename SampleType>
+class EnvelopeFollower {
+public:
+    static constexpr int segmentLength = 16;
+
+    auto prepare(double newSampleRate, int maxBlockSize) -> void {
+        this->sampleRate = newSampleRate;
+        auto maxSegments = (std::max(1, maxBlockSize) + EnvelopeFollower::segmentLength - 1) / EnvelopeFollower::segmentLength;
+
+        this->peaks.assign(static_cast<size_t>(maxSegments), SampleType(0));
+        this->targets.assign(static_cast<size_t>(maxSegments), SampleType(1));
+
+        this->updateCoefficients();
+        this->reset();
+    }
+
+    auto reset() -> void {
+        this->envelope = SampleType(0);
+        this->gain = SampleType(1);
+        this->idle = true;
+    }
+
+    // Amount is the gain reduction at a full scale sidechain, times are in milliseconds
+    auto setParameters(SampleType newAmount, SampleType newAttackMs, SampleType newReleaseMs) -> void {
+        this->amount = std::clamp(newAmount, SampleType(0), SampleType(1));
+        this->enabled = this->amount > SampleType(0);
+
+        // islessgreater is a plain inequality that doesn't warn under -Wfloat-equal and is false for NaN
+        if (std::islessgreater(newAttackMs, this->attackMs) || std::islessgreater(newReleaseMs, this->releaseMs)) {
+            this->attackMs = newAttackMs;
+            this->releaseMs = newReleaseMs;
+            this->coefficientsDirty = true;
+        }
+    }
+
+    // Detects one block, returns false when the duck gain is unity and there is nothing to apply
+    auto process(const SampleType* left, const SampleType* right, int numSamples, const KernelTable<SampleType>& kernels) -> bool {
+        if ((left == nullptr || !this->enabled) && this->idle) return false;
+        if (this->coefficientsDirty) this->updateCoefficients();
+
+        int numSegments = (numSamples + EnvelopeFollower::segmentLength - 1) / EnvelopeFollower::segmentLength;
+        SampleType blockPeak = SampleType(0);
+
+        if (left != nullptr) {
+            blockPeak = kernels.segmentPeaks(left, right, this->peaks.data(), EnvelopeFollower::segmentLength, numSamples);
+        }
+
+        if (blockPeak < EnvelopeFollower::silence && this->idle) return false;
+        if (left == nullptr) std::fill_n(this->peaks.begin(), numSegments, SampleType(0));
+
+        this->start = this->gain;
+
+        for (size_t segment = 0; segment < static_cast<size_t>(numSegments); segment++) {
+            auto peak = this->peaks[segment];
+            auto coefficient = peak > this->envelope ? this->attack : this->release;
+            this->envelope = peak + coefficient * (this->envelope - peak);
+
+            // A released envelope snaps to exactly zero, so the duck gain lands on exactly one
+            this->idle = this->envelope < EnvelopeFollower::silence;
+            if (this->idle) this->envelope = SampleType(0);
+
+            this->targets[segment] = SampleType(1) - this->amount * std::min(this->envelope, SampleType(1));
+        }
+
+        this->gain = this->targets[static_cast<size_t>(numSegments - 1)];
+        return true;
+    }
+
+    // Multiplies the block's gain coefficients by the duck gain detected in process
+    auto apply(SampleType* dest, int numSamples, const KernelTable<SampleType>& kernels) const -> void {
+        kernels.applySegmentRamps(dest, this->targets.data(), this->start, EnvelopeFollower::segmentLength, numSamples);
+    }
+
+private:
+    // -100 dB, below this the envelope snaps to zero so a released ducker goes idle
+    static constexpr SampleType silence = SampleType(0.00001);
+
+    double sampleRate = 44100.0;
+    SampleType amount = SampleType(0);
+    SampleType attackMs = SampleType(5);
+    SampleType releaseMs = SampleType(150);
+    SampleType attack = SampleType(0);
+    SampleType release = SampleType(0);
+
+    SampleType envelope = SampleType(0);
+    SampleType gain = SampleType(1);
+    SampleType start = SampleType(1);
+
+    // Idle while the envelope sits at zero and the duck gain at one, enabled while amount is above zero
+    bool idle = true;
+    bool enabled = false;
+    bool coefficientsDirty = false;
+
+    std::vector<SampleType> peaks;
+    std::vector<SampleType> targets;
+
+    auto updateCoefficients() -> void {
+        auto coefficient = [this](SampleType timeMs) {
+            double samples = std::max(0.001, static_cast<double>(timeMs)) * 0.001 * this->sampleRate;
+            return static_cast<SampleType>(std::exp(-static_cast<double>(EnvelopeFollower::segmentLength) / samples));
+        };
+
+        this->attack = coefficient(this->attackMs);
+        this->release = coefficient(this->releaseMs);
+        this->coefficientsDirty = false;
+    }
+};
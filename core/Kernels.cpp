@@ -0,0 +1,124 @@
+#include <string_view>
+#include "KernelsImpl.hpp"
+
+#if GAIN_BOOSTER_X86_KERNELS && defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+auto getScalarKernels() -> const KernelSet& {
+    static const auto kernels = makeKernelSet<ScalarVec>(KernelISA::scalar);
+    return kernels;
+}
+
+#if GAIN_BOOSTER_X86_KERNELS
+    #if defined(_MSC_VER) && !defined(__clang__)
+        // cpuid leaves 1 and 7 plus xgetbv, so the OS has to save the wider registers too
+        static auto hasCPUFeature(KernelISA isa) -> bool {
+            int info[4];
+            __cpuid(info, 0);
+            int maxLeaf = info[0];
+
+            __cpuid(info, 1);
+            bool sse2 = (info[3] & (1 << 26)) != 0;
+            bool fma = (info[2] & (1 << 12)) != 0;
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (isa == KernelISA::sse2) return sse2;
+            if (!osxsave || maxLeaf < 7) return false;
+
+            auto xcr0 = _xgetbv(0);
+            __cpuidex(info, 7, 0);
+
+            if (isa == KernelISA::avx2) return (xcr0 & 0x6) == 0x6 && fma && (info[1] & (1 << 5)) != 0;
+            if (isa == KernelISA::avx512) return (xcr0 & 0xe6) == 0xe6 && (info[1] & (1 << 16)) != 0;
+            return false;
+        }
+    #else
+        static auto hasCPUFeature(KernelISA isa) -> bool {
+            __builtin_cpu_init();
+
+            switch (isa) {
+                case KernelISA::sse2: return __builtin_cpu_supports("sse2");
+                case KernelISA::avx2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+                case KernelISA::avx512: return __builtin_cpu_supports("avx512f");
+                case KernelISA::scalar:
+                case KernelISA::neon: return false;
+            }
+            return false;
+        }
+    #endif
+#endif
+
+auto Kernels::isSupported(KernelISA isa) -> bool {
+    switch (isa) {
+        case KernelISA::scalar: return true;
+        #if GAIN_BOOSTER_X86_KERNELS
+            case KernelISA::sse2:
+            case KernelISA::avx2:
+            case KernelISA::avx512: {
+                static const bool supported[3] = {
+                    hasCPUFeature(KernelISA::sse2), hasCPUFeature(KernelISA::avx2), hasCPUFeature(KernelISA::avx512)
+                };
+                return supported[static_cast<int>(isa) - static_cast<int>(KernelISA::sse2)];
+            }
+        #else
+            case KernelISA::sse2:
+            case KernelISA::avx2:
+            case KernelISA::avx512: return false;
+        #endif
+        // Advanced SIMD is mandatory on AArch64
+        case KernelISA::neon: return GAIN_BOOSTER_NEON_KERNELS;
+    }
+    return false;
+}
+
+auto Kernels::detectISA() -> KernelISA {
+    #ifdef GAIN_BOOSTER_FORCE_ISA
+        for (auto isa : {KernelISA::scalar, KernelISA::sse2, KernelISA::avx2, KernelISA::avx512, KernelISA::neon}) {
+            if (std::string_view{Kernels::getISAName(isa)} == GAIN_BOOSTER_FORCE_ISA) {
+                if (Kernels::isSupported(isa)) return isa;
+            }
+        }
+    #endif
+
+    for (auto isa : {KernelISA::avx512, KernelISA::avx2, KernelISA::neon, KernelISA::sse2}) {
+        if (Kernels::isSupported(isa)) return isa;
+    }
+
+    return KernelISA::scalar;
+}
+
+auto Kernels::getKernels(KernelISA isa) -> const KernelSet& {
+    if (!Kernels::isSupported(isa)) return getScalarKernels();
+
+    // Every case is listed so a new ISA can't silently fall back to scalar, isSupported already
+    // rejected the ones this build has no kernels for
+    switch (isa) {
+        case KernelISA::scalar: return getScalarKernels();
+        #if GAIN_BOOSTER_X86_KERNELS
+            case KernelISA::sse2: return getSSE2Kernels();
+            case KernelISA::avx2: return getAVX2Kernels();
+            case KernelISA::avx512: return getAVX512Kernels();
+        #else
+            case KernelISA::sse2:
+            case KernelISA::avx2:
+            case KernelISA::avx512: return getScalarKernels();
+        #endif
+        #if GAIN_BOOSTER_NEON_KERNELS
+            case KernelISA::neon: return getNEONKernels();
+        #else
+            case KernelISA::neon: return getScalarKernels();
+        #endif
+    }
+    return getScalarKernels();
+}
+
+auto Kernels::getISAName(KernelISA isa) -> const char* {
+    switch (isa) {
+        case KernelISA::scalar: return "scalar";
+        case KernelISA::sse2: return "sse2";
+        case KernelISA::avx2: return "avx2";
+        case KernelISA::avx512: return "avx512";
+        case KernelISA::neon: return "neon";
+    }
+    return "scalar";
+}
@@ -0,0 +1,172 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define GAIN_BOOSTER_X86_KERNELS 1
+#else
+    #define GAIN_BOOSTER_X86_KERNELS 0
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #define GAIN_BOOSTER_NEON_KERNELS 1
+#else
+    #define GAIN_BOOSTER_NEON_KERNELS 0
+#endif
+
+enum class KernelISA {
+    scalar,
+    sse2,
+    avx2,
+    avx512,
+    neon
+};
+
+enum class LFOShape {
+    square,
+    saw,
+    triangle,
+    sine
+};
+
+// Enum orders match the plugin's choice parameters so indices convert directly
+enum class ResponseCurve {
+    logarithmic,
+    linear,
+    exponential
+};
+
+enum class PanLaw {
+    constant,
+    triangle,
+    linear
+};
+
+// Interleaved stereo sample formats, integer formats are little-endian
+enum class PCMFormat {
+    float32,
+    int16,
+    int24
+};
+
+template <typename SampleType>
+struct BlockStats {
+    SampleType peak;
+    int nonFinite;
+    int outOfRange;
+};
+
+// Per-stream state for processStreams, every pointer addresses one value per stream. Curves,
+// pan laws and LFO shapes are their enum values stored as SampleType
+template <typename SampleType>
+struct StreamLanes {
+    // Same countdown ramp as Smoother, remaining is the number of steps left
+    struct Ramp {
+        SampleType* current;
+        const SampleType* target;
+        const SampleType* step;
+        SampleType* remaining;
+    };
+
+    Ramp gain;
+    Ramp boost;
+    Ramp pan;
+    Ramp gainLFOAmount;
+    Ramp panLFOAmount;
+
+    const SampleType* gainCurve;
+    const SampleType* boostCurve;
+    const SampleType* panningLaw;
+    const SampleType* gainLFOShape;
+    const SampleType* panLFOShape;
+
+    SampleType* gainLFOPhase;
+    SampleType* panLFOPhase;
+    const SampleType* gainLFOIncrement;
+    const SampleType* panLFOIncrement;
+
+    SampleType maxBoost;
+};
+
+template <typename SampleType>
+struct KernelTable {
+    auto (*applyGainPan)(const SampleType* inputL, const SampleType* inputR, SampleType* outputL, SampleType* outputR,
+        const SampleType* gain, const SampleType* panL, const SampleType* panR, int numSamples) -> void;
+
+    // In place on interleaved stereo frames (L R L R ...)
+    auto (*applyGainPanInterleaved)(SampleType* frames, const SampleType* gain, const SampleType* panL, 
+        const SampleType* panR, int numFrames) -> void;
+
+    // Every shape renders a register at a time, the sine through the same degree 9 polynomial as processStreams
+    auto (*renderLFO)(SampleType* dest, SampleType phase, SampleType increment, 
+        LFOShape shape, bool invert, int numSamples) -> SampleType;
+
+    // Same shapes and phase as renderLFO for audio rates: PolyBLEP corrected square and saw, PolyBLAMP
+    // corrected triangle, polynomial sine
+    auto (*renderOscillator)(SampleType* dest, SampleType phase, SampleType increment, 
+        LFOShape shape, bool invert, int numSamples) -> SampleType;
+
+    auto (*measureBlock)(const SampleType* data, int numSamples, SampleType limit) -> BlockStats<SampleType>;
+
+    // dest += source * scale
+    auto (*multiplyAdd)(SampleType* dest, const SampleType* source, SampleType scale, int numSamples) -> void;
+
+    // Peak of |left| and |right| over each segmentLength run of samples, returns the peak of the whole block
+    auto (*segmentPeaks)(const SampleType* left, const SampleType* right, SampleType* peaks, 
+        int segmentLength, int numSamples) -> SampleType;
+
+    // Multiplies dest by a linear ramp per segment, from the previous segment's target to targets[segment]
+    auto (*applySegmentRamps)(SampleType* dest, const SampleType* targets, SampleType start, 
+        int segmentLength, int numSamples) -> void;
+
+    // Gain, boost, pan law and both LFOs for many streams, SIMD lanes run across streams. Buffers are
+    // stream-interleaved, data[sample * numStreams + stream]
+    auto (*processStreams)(const StreamLanes<SampleType>& lanes, const SampleType* inputL, const SampleType* inputR,
+        SampleType* outputL, SampleType* outputR, int numStreams, int numSamples) -> void;
+};
+
+// Integer PCM converts to float, applies the coefficients and converts back with rounding and saturation
+struct PCMKernelTable {
+    auto (*applyGainPanInt16)(int16_t* frames, const float* gain, const float* panL, const float* panR, int numFrames) -> void;
+    auto (*applyGainPanInt24)(uint8_t* frames, const float* gain, const float* panL, const float* panR, int numFrames) -> void;
+};
+
+struct KernelSet {
+    KernelISA isa;
+    KernelTable<float> floats;
+    KernelTable<double> doubles;
+    PCMKernelTable pcm;
+};
+
+auto getScalarKernels() -> const KernelSet&;
+
+#if GAIN_BOOSTER_X86_KERNELS
+    auto getSSE2Kernels() -> const KernelSet&;
+    auto getAVX2Kernels() -> const KernelSet&;
+    auto getAVX512Kernels() -> const KernelSet&;
+#endif
+
+#if GAIN_BOOSTER_NEON_KERNELS
+    auto getNEONKernels() -> const KernelSet&;
+#endif
+
+class Kernels {
+public:
+    static auto detectISA() -> KernelISA;
+    static auto isSupported(KernelISA isa) -> bool;
+    static auto getKernels(KernelISA isa) -> const KernelSet&;
+    static auto getISAName(KernelISA isa) -> const char*;
+
+    static auto getPCMTable(KernelISA isa) -> const PCMKernelTable& {
+        return getKernels(isa).pcm;
+    }
+
+    template <typename SampleType>
+    static auto getTable(KernelISA isa) -> const KernelTable<SampleType>& {
+        if constexpr (std::is_same_v<SampleType, double>) {
+            return getKernels(isa).doubles;
+        } else {
+            return getKernels(isa).floats;
+        }
+    }
+};
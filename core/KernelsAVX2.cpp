@@ -0,0 +1,122 @@
+#include "KernelsImpl.hpp"
+
+#if GAIN_BOOSTER_X86_KERNELS
+#include <immintrin.h>
+
+namespace {
+
+template <typename SampleType>
+struct AVX2Vec;
+
+template <>
+struct AVX2Vec<float> {
+    using Scalar = float;
+    using Register = __m256;
+    using Mask = __m256;
+    static constexpr int width = 8;
+
+    static inline auto load(const float* data) -> Register { return _mm256_loadu_ps(data); }
+    static inline auto store(float* data, Register value) -> void { _mm256_storeu_ps(data, value); }
+    static inline auto set1(float value) -> Register { return _mm256_set1_ps(value); }
+    static inline auto ramp() -> Register { return _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f); }
+    static inline auto add(Register a, Register b) -> Register { return _mm256_add_ps(a, b); }
+    static inline auto sub(Register a, Register b) -> Register { return _mm256_sub_ps(a, b); }
+    static inline auto mul(Register a, Register b) -> Register { return _mm256_mul_ps(a, b); }
+    static inline auto abs(Register a) -> Register { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static inline auto max(Register a, Register b) -> Register { return _mm256_max_ps(a, b); }
+    static inline auto min(Register a, Register b) -> Register { return _mm256_min_ps(a, b); }
+    static inline auto div(Register a, Register b) -> Register { return _mm256_div_ps(a, b); }
+    static inline auto sqrt(Register a) -> Register { return _mm256_sqrt_ps(a); }
+    static inline auto cmplt(Register a, Register b) -> Mask { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static inline auto cmpgt(Register a, Register b) -> Mask { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static inline auto maskAnd(Mask a, Mask b) -> Mask { return _mm256_and_ps(a, b); }
+    static inline auto select(Mask mask, Register a, Register b) -> Register { return _mm256_blendv_ps(b, a, mask); }
+    static inline auto countMask(Mask mask) -> int { return std::popcount(static_cast<unsigned>(_mm256_movemask_ps(mask))); }
+    static inline auto fract(Register a) -> Register { return _mm256_sub_ps(a, _mm256_floor_ps(a)); }
+
+    // unpack interleaves within each 128-bit lane, the permutes put the lanes back in frame order
+    static inline auto zipLow(Register a, Register b) -> Register {
+        return _mm256_permute2f128_ps(_mm256_unpacklo_ps(a, b), _mm256_unpackhi_ps(a, b), 0x20);
+    }
+
+    static inline auto zipHigh(Register a, Register b) -> Register {
+        return _mm256_permute2f128_ps(_mm256_unpacklo_ps(a, b), _mm256_unpackhi_ps(a, b), 0x31);
+    }
+
+    static inline auto loadInt16(const int16_t* data) -> Register {
+        return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))));
+    }
+
+    static inline auto storeInt16(int16_t* data, Register value) -> void {
+        auto rounded = _mm256_cvtps_epi32(value);
+        auto packed = _mm_packs_epi32(_mm256_castsi256_si128(rounded), _mm256_extracti128_si256(rounded, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data), packed);
+    }
+
+    static inline auto isFinite(Register a) -> Mask {
+        auto exponent = _mm256_set1_epi32(0x7f800000);
+        auto bits = _mm256_and_si256(_mm256_castps_si256(a), exponent);
+        return _mm256_castsi256_ps(_mm256_xor_si256(_mm256_cmpeq_epi32(bits, exponent), _mm256_set1_epi32(-1)));
+    }
+
+    static inline auto hmax(Register a) -> float {
+        auto half = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        auto upper = _mm_max_ps(half, _mm_movehl_ps(half, half));
+        return _mm_cvtss_f32(_mm_max_ss(upper, _mm_shuffle_ps(upper, upper, 1)));
+    }
+};
+
+template <>
+struct AVX2Vec<double> {
+    using Scalar = double;
+    using Register = __m256d;
+    using Mask = __m256d;
+    static constexpr int width = 4;
+
+    static inline auto load(const double* data) -> Register { return _mm256_loadu_pd(data); }
+    static inline auto store(double* data, Register value) -> void { _mm256_storeu_pd(data, value); }
+    static inline auto set1(double value) -> Register { return _mm256_set1_pd(value); }
+    static inline auto ramp() -> Register { return _mm256_setr_pd(0.0, 1.0, 2.0, 3.0); }
+    static inline auto add(Register a, Register b) -> Register { return _mm256_add_pd(a, b); }
+    static inline auto sub(Register a, Register b) -> Register { return _mm256_sub_pd(a, b); }
+    static inline auto mul(Register a, Register b) -> Register { return _mm256_mul_pd(a, b); }
+    static inline auto abs(Register a) -> Register { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static inline auto max(Register a, Register b) -> Register { return _mm256_max_pd(a, b); }
+    static inline auto min(Register a, Register b) -> Register { return _mm256_min_pd(a, b); }
+    static inline auto div(Register a, Register b) -> Register { return _mm256_div_pd(a, b); }
+    static inline auto sqrt(Register a) -> Register { return _mm256_sqrt_pd(a); }
+    static inline auto cmplt(Register a, Register b) -> Mask { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static inline auto cmpgt(Register a, Register b) -> Mask { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static inline auto maskAnd(Mask a, Mask b) -> Mask { return _mm256_and_pd(a, b); }
+    static inline auto select(Mask mask, Register a, Register b) -> Register { return _mm256_blendv_pd(b, a, mask); }
+    static inline auto countMask(Mask mask) -> int { return std::popcount(static_cast<unsigned>(_mm256_movemask_pd(mask))); }
+    static inline auto fract(Register a) -> Register { return _mm256_sub_pd(a, _mm256_floor_pd(a)); }
+
+    static inline auto zipLow(Register a, Register b) -> Register {
+        return _mm256_permute2f128_pd(_mm256_unpacklo_pd(a, b), _mm256_unpackhi_pd(a, b), 0x20);
+    }
+
+    static inline auto zipHigh(Register a, Register b) -> Register {
+        return _mm256_permute2f128_pd(_mm256_unpacklo_pd(a, b), _mm256_unpackhi_pd(a, b), 0x31);
+    }
+
+    static inline auto isFinite(Register a) -> Mask {
+        auto exponent = _mm256_set1_epi64x(0x7ff0000000000000ll);
+        auto bits = _mm256_and_si256(_mm256_castpd_si256(a), exponent);
+        return _mm256_castsi256_pd(_mm256_xor_si256(_mm256_cmpeq_epi64(bits, exponent), _mm256_set1_epi64x(-1)));
+    }
+
+    static inline auto hmax(Register a) -> double {
+        auto half = _mm_max_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+        return _mm_cvtsd_f64(_mm_max_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+};
+
+}
+
+auto getAVX2Kernels() -> const KernelSet& {
+    static const auto kernels = makeKernelSet<AVX2Vec>(KernelISA::avx2);
+    return kernels;
+}
+
+#endif
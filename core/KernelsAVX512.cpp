@@ -0,0 +1,116 @@
+#include "KernelsImpl.hpp"
+
+#if GAIN_BOOSTER_X86_KERNELS
+#include <immintrin.h>
+
+namespace {
+
+template <typename SampleType>
+struct AVX512Vec;
+
+template <>
+struct AVX512Vec<float> {
+    using Scalar = float;
+    using Register = __m512;
+    using Mask = __mmask16;
+    static constexpr int width = 16;
+
+    static inline auto load(const float* data) -> Register { return _mm512_loadu_ps(data); }
+    static inline auto store(float* data, Register value) -> void { _mm512_storeu_ps(data, value); }
+    static inline auto set1(float value) -> Register { return _mm512_set1_ps(value); }
+    static inline auto add(Register a, Register b) -> Register { return _mm512_add_ps(a, b); }
+    static inline auto sub(Register a, Register b) -> Register { return _mm512_sub_ps(a, b); }
+    static inline auto mul(Register a, Register b) -> Register { return _mm512_mul_ps(a, b); }
+    static inline auto abs(Register a) -> Register { return _mm512_abs_ps(a); }
+    static inline auto max(Register a, Register b) -> Register { return _mm512_max_ps(a, b); }
+    static inline auto min(Register a, Register b) -> Register { return _mm512_min_ps(a, b); }
+    static inline auto div(Register a, Register b) -> Register { return _mm512_div_ps(a, b); }
+    static inline auto sqrt(Register a) -> Register { return _mm512_sqrt_ps(a); }
+    static inline auto cmplt(Register a, Register b) -> Mask { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static inline auto cmpgt(Register a, Register b) -> Mask { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static inline auto maskAnd(Mask a, Mask b) -> Mask { return static_cast<Mask>(a & b); }
+    static inline auto select(Mask mask, Register a, Register b) -> Register { return _mm512_mask_blend_ps(mask, b, a); }
+    static inline auto countMask(Mask mask) -> int { return std::popcount(static_cast<unsigned>(mask)); }
+    static inline auto fract(Register a) -> Register { return _mm512_sub_ps(a, _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF)); }
+    static inline auto hmax(Register a) -> float { return _mm512_reduce_max_ps(a); }
+
+    static inline auto zipLow(Register a, Register b) -> Register {
+        auto indices = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+        return _mm512_permutex2var_ps(a, indices, b);
+    }
+
+    static inline auto zipHigh(Register a, Register b) -> Register {
+        auto indices = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+        return _mm512_permutex2var_ps(a, indices, b);
+    }
+
+    static inline auto loadInt16(const int16_t* data) -> Register {
+        return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data))));
+    }
+
+    static inline auto storeInt16(int16_t* data, Register value) -> void {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(value)));
+    }
+
+    static inline auto ramp() -> Register {
+        return _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 
+            8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f);
+    }
+
+    static inline auto isFinite(Register a) -> Mask {
+        auto exponent = _mm512_set1_epi32(0x7f800000);
+        auto bits = _mm512_and_si512(_mm512_castps_si512(a), exponent);
+        return _mm512_cmpneq_epi32_mask(bits, exponent);
+    }
+};
+
+template <>
+struct AVX512Vec<double> {
+    using Scalar = double;
+    using Register = __m512d;
+    using Mask = __mmask8;
+    static constexpr int width = 8;
+
+    static inline auto load(const double* data) -> Register { return _mm512_loadu_pd(data); }
+    static inline auto store(double* data, Register value) -> void { _mm512_storeu_pd(data, value); }
+    static inline auto set1(double value) -> Register { return _mm512_set1_pd(value); }
+    static inline auto ramp() -> Register { return _mm512_setr_pd(0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0); }
+    static inline auto add(Register a, Register b) -> Register { return _mm512_add_pd(a, b); }
+    static inline auto sub(Register a, Register b) -> Register { return _mm512_sub_pd(a, b); }
+    static inline auto mul(Register a, Register b) -> Register { return _mm512_mul_pd(a, b); }
+    static inline auto abs(Register a) -> Register { return _mm512_abs_pd(a); }
+    static inline auto max(Register a, Register b) -> Register { return _mm512_max_pd(a, b); }
+    static inline auto min(Register a, Register b) -> Register { return _mm512_min_pd(a, b); }
+    static inline auto div(Register a, Register b) -> Register { return _mm512_div_pd(a, b); }
+    static inline auto sqrt(Register a) -> Register { return _mm512_sqrt_pd(a); }
+    static inline auto cmplt(Register a, Register b) -> Mask { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static inline auto cmpgt(Register a, Register b) -> Mask { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static inline auto maskAnd(Mask a, Mask b) -> Mask { return static_cast<Mask>(a & b); }
+    static inline auto select(Mask mask, Register a, Register b) -> Register { return _mm512_mask_blend_pd(mask, b, a); }
+    static inline auto countMask(Mask mask) -> int { return std::popcount(static_cast<unsigned>(mask)); }
+    static inline auto fract(Register a) -> Register { return _mm512_sub_pd(a, _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF)); }
+    static inline auto hmax(Register a) -> double { return _mm512_reduce_max_pd(a); }
+
+    static inline auto zipLow(Register a, Register b) -> Register {
+        return _mm512_permutex2var_pd(a, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), b);
+    }
+
+    static inline auto zipHigh(Register a, Register b) -> Register {
+        return _mm512_permutex2var_pd(a, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), b);
+    }
+
+    static inline auto isFinite(Register a) -> Mask {
+        auto exponent = _mm512_set1_epi64(0x7ff0000000000000ll);
+        auto bits = _mm512_and_si512(_mm512_castpd_si512(a), exponent);
+        return _mm512_cmpneq_epi64_mask(bits, exponent);
+    }
+};
+
+}
+
+auto getAVX512Kernels() -> const KernelSet& {
+    static const auto kernels = makeKernelSet<AVX512Vec>(KernelISA::avx512);
+    return kernels;
+}
+
+#endif
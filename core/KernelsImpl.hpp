@@ -0,0 +1,592 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include "Kernels.h"
+
+// Each ISA translation unit compiles this with its own target flags, so everything here has internal
+// linkage: a shared instantiation could otherwise be deduplicated to the AVX copy at link time
+namespace {
+
+template <typename SampleType>
+struct ScalarVec {
+    using Scalar = SampleType;
+    using Register = SampleType;
+    using Mask = bool;
+    static constexpr int width = 1;
+
+    static inline auto load(const SampleType* data) -> Register { return *data; }
+    static inline auto store(SampleType* data, Register value) -> void { *data = value; }
+    static inline auto set1(SampleType value) -> Register { return value; }
+    static inline auto ramp() -> Register { return SampleType(0); }
+    static inline auto add(Register a, Register b) -> Register { return a + b; }
+    static inline auto sub(Register a, Register b) -> Register { return a - b; }
+    static inline auto mul(Register a, Register b) -> Register { return a * b; }
+    static inline auto abs(Register a) -> Register { return std::abs(a); }
+    static inline auto max(Register a, Register b) -> Register { return a > b ? a : b; }
+    static inline auto min(Register a, Register b) -> Register { return a < b ? a : b; }
+    static inline auto div(Register a, Register b) -> Register { return a / b; }
+    static inline auto sqrt(Register a) -> Register { return std::sqrt(a); }
+    static inline auto cmplt(Register a, Register b) -> Mask { return a < b; }
+    static inline auto cmpgt(Register a, Register b) -> Mask { return a > b; }
+    static inline auto maskAnd(Mask a, Mask b) -> Mask { return a && b; }
+    static inline auto select(Mask mask, Register a, Register b) -> Register { return mask ? a : b; }
+    static inline auto countMask(Mask mask) -> int { return mask ? 1 : 0; }
+    static inline auto fract(Register a) -> Register { return a - std::floor(a); }
+    static inline auto hmax(Register a) -> SampleType { return a; }
+    static inline auto loadInt16(const int16_t* data) -> Register { return static_cast<SampleType>(*data); }
+
+    static inline auto storeInt16(int16_t* data, Register value) -> void {
+        *data = static_cast<int16_t>(std::lrint(std::clamp(value, SampleType(-32768), SampleType(32767))));
+    }
+
+    static inline auto isFinite(Register a) -> Mask {
+        // Checked on the exponent bits so fast-math builds cannot fold it away
+        if constexpr (std::is_same_v<SampleType, double>) {
+            return (std::bit_cast<uint64_t>(a) & 0x7ff0000000000000ull) != 0x7ff0000000000000ull;
+        } else {
+            return (std::bit_cast<uint32_t>(a) & 0x7f800000u) != 0x7f800000u;
+        }
+    }
+};
+
+template <typename Vec>
+class KernelsImpl {
+public:
+    using SampleType = typename Vec::Scalar;
+    using Scalar = ScalarVec<SampleType>;
+    static constexpr int width = Vec::width;
+
+    static auto applyGainPan(const SampleType* inputL, const SampleType* inputR, SampleType* outputL, SampleType* outputR,
+        const SampleType* gain, const SampleType* panL, const SampleType* panR, int numSamples) -> void {
+        int sample = 0;
+
+        for (; sample + width <= numSamples; sample += width) {
+            auto sampleGain = Vec::load(gain + sample);
+            Vec::store(outputL + sample, Vec::mul(Vec::mul(Vec::load(inputL + sample), sampleGain), Vec::load(panL + sample)));
+            Vec::store(outputR + sample, Vec::mul(Vec::mul(Vec::load(inputR + sample), sampleGain), Vec::load(panR + sample)));
+        }
+
+        for (; sample < numSamples; sample++) {
+            outputL[sample] = inputL[sample] * gain[sample] * panL[sample];
+            outputR[sample] = inputR[sample] * gain[sample] * panR[sample];
+        }
+    }
+
+    static auto applyGainPanInterleaved(SampleType* frames, const SampleType* gain, const SampleType* panL,
+        const SampleType* panR, int numFrames) -> void {
+        int frame = 0;
+
+        if constexpr (width > 1) {
+            for (; frame + width <= numFrames; frame += width) {
+                auto [low, high] = interleavedCoefficients(gain, panL, panR, frame);
+                auto* data = frames + 2 * frame;
+
+                Vec::store(data, Vec::mul(Vec::load(data), low));
+                Vec::store(data + width, Vec::mul(Vec::load(data + width), high));
+            }
+        }
+
+        for (; frame < numFrames; frame++) {
+            frames[2 * frame] *= gain[frame] * panL[frame];
+            frames[2 * frame + 1] *= gain[frame] * panR[frame];
+        }
+    }
+
+    static auto applyGainPanInt16(int16_t* frames, const SampleType* gain, const SampleType* panL,
+        const SampleType* panR, int numFrames) -> void {
+        int frame = 0;
+
+        if constexpr (width > 1) {
+            for (; frame + width <= numFrames; frame += width) {
+                auto [low, high] = interleavedCoefficients(gain, panL, panR, frame);
+                auto* data = frames + 2 * frame;
+
+                Vec::storeInt16(data, Vec::mul(Vec::loadInt16(data), low));
+                Vec::storeInt16(data + width, Vec::mul(Vec::loadInt16(data + width), high));
+            }
+        }
+
+        for (; frame < numFrames; frame++) {
+            auto* data = frames + 2 * frame;
+            Scalar::storeInt16(data, Scalar::loadInt16(data) * gain[frame] * panL[frame]);
+            Scalar::storeInt16(data + 1, Scalar::loadInt16(data + 1) * gain[frame] * panR[frame]);
+        }
+    }
+
+    static auto applyGainPanInt24(uint8_t* frames, const SampleType* gain, const SampleType* panL,
+        const SampleType* panR, int numFrames) -> void {
+        // Packed 24-bit has no cheap vector unpack below AVX-512 VBMI, so each chunk is widened
+        // into a register-sized scratch, scaled with the interleaved kernel and packed again
+        constexpr int chunkFrames = std::max(width, 8);
+        SampleType scratch[2 * static_cast<size_t>(chunkFrames)];
+
+        for (int frame = 0; frame < numFrames; frame += chunkFrames) {
+            int chunk = std::min(chunkFrames, numFrames - frame);
+            auto numChunkSamples = 2 * static_cast<size_t>(chunk);
+            auto* data = frames + 6 * static_cast<size_t>(frame);
+
+            for (size_t sample = 0; sample < numChunkSamples; sample++) {
+                scratch[sample] = static_cast<SampleType>(readInt24(data + 3 * sample));
+            }
+
+            applyGainPanInterleaved(scratch, gain + frame, panL + frame, panR + frame, chunk);
+
+            for (size_t sample = 0; sample < numChunkSamples; sample++) {
+                writeInt24(data + 3 * sample, scratch[sample]);
+            }
+        }
+    }
+
+    static auto renderLFO(SampleType* dest, SampleType phase, SampleType increment,
+        LFOShape shape, bool invert, int numSamples) -> SampleType {
+        switch (shape) {
+            case LFOShape::square: return renderShape<LFOShape::square>(dest, phase, increment, invert, numSamples);
+            case LFOShape::saw: return renderShape<LFOShape::saw>(dest, phase, increment, invert, numSamples);
+            case LFOShape::triangle: return renderShape<LFOShape::triangle>(dest, phase, increment, invert, numSamples);
+            case LFOShape::sine: return renderShape<LFOShape::sine>(dest, phase, increment, invert, numSamples);
+        }
+        return phase;
+    }
+
+    static auto renderOscillator(SampleType* dest, SampleType phase, SampleType increment,
+        LFOShape shape, bool invert, int numSamples) -> SampleType {
+        switch (shape) {
+            case LFOShape::square: return renderBandlimited<LFOShape::square>(dest, phase, increment, invert, numSamples);
+            case LFOShape::saw: return renderBandlimited<LFOShape::saw>(dest, phase, increment, invert, numSamples);
+            case LFOShape::triangle: return renderBandlimited<LFOShape::triangle>(dest, phase, increment, invert, numSamples);
+            case LFOShape::sine: return renderBandlimited<LFOShape::sine>(dest, phase, increment, invert, numSamples);
+        }
+        return phase;
+    }
+
+    static auto measureBlock(const SampleType* data, int numSamples, SampleType limit) -> BlockStats<SampleType> {
+        auto peak = Vec::set1(SampleType(0));
+        auto limitVec = Vec::set1(limit);
+        int nonFinite = 0;
+        int outOfRange = 0;
+        int sample = 0;
+
+        for (; sample + width <= numSamples; sample += width) {
+            auto value = Vec::load(data + sample);
+            auto finite = Vec::isFinite(value);
+            auto magnitude = Vec::select(finite, Vec::abs(value), Vec::set1(SampleType(0)));
+
+            nonFinite += width - Vec::countMask(finite);
+            outOfRange += Vec::countMask(Vec::cmpgt(magnitude, limitVec));
+            peak = Vec::max(peak, magnitude);
+        }
+
+        SampleType tailPeak = SampleType(0);
+
+        for (; sample < numSamples; sample++) {
+            auto value = data[sample];
+
+            if (!Scalar::isFinite(value)) {
+                nonFinite++;
+                continue;
+            }
+
+            auto magnitude = std::abs(value);
+            if (magnitude > limit) outOfRange++;
+            tailPeak = std::max(tailPeak, magnitude);
+        }
+
+        return {std::max(Vec::hmax(peak), tailPeak), nonFinite, outOfRange};
+    }
+
+    static auto multiplyAdd(SampleType* dest, const SampleType* source, SampleType scale, int numSamples) -> void {
+        auto scaleVec = Vec::set1(scale);
+        int sample = 0;
+
+        for (; sample + width <= numSamples; sample += width) {
+            Vec::store(dest + sample, Vec::add(Vec::load(dest + sample), Vec::mul(Vec::load(source + sample), scaleVec)));
+        }
+
+        for (; sample < numSamples; sample++) {
+            dest[sample] += source[sample] * scale;
+        }
+    }
+
+    static auto segmentPeaks(const SampleType* left, const SampleType* right, SampleType* peaks, 
+        int segmentLength, int numSamples) -> SampleType {
+        SampleType blockPeak = SampleType(0);
+
+        for (int offset = 0, segment = 0; offset < numSamples; offset += segmentLength, segment++) {
+            int end = std::min(numSamples, offset + segmentLength);
+            auto peak = Vec::set1(SampleType(0));
+            int sample = offset;
+
+            for (; sample + width <= end; sample += width) {
+                auto rectified = Vec::max(Vec::abs(Vec::load(left + sample)), Vec::abs(Vec::load(right + sample)));
+                peak = Vec::max(peak, rectified);
+            }
+
+            SampleType segmentPeak = Vec::hmax(peak);
+
+            for (; sample < end; sample++) {
+                segmentPeak = std::max(segmentPeak, std::max(std::abs(left[sample]), std::abs(right[sample])));
+            }
+
+            peaks[segment] = segmentPeak;
+            blockPeak = std::max(blockPeak, segmentPeak);
+        }
+
+        return blockPeak;
+    }
+
+    static auto applySegmentRamps(SampleType* dest, const SampleType* targets, SampleType start, 
+        int segmentLength, int numSamples) -> void {
+        auto steps = Vec::add(Vec::ramp(), Vec::set1(SampleType(1)));
+
+        for (int offset = 0, segment = 0; offset < numSamples; offset += segmentLength, segment++) {
+            int end = std::min(numSamples, offset + segmentLength);
+            auto target = targets[segment];
+            auto step = (target - start) / static_cast<SampleType>(end - offset);
+            auto stepVec = Vec::set1(step);
+            int sample = offset;
+
+            for (; sample + width <= end; sample += width) {
+                auto base = Vec::set1(start + step * static_cast<SampleType>(sample - offset));
+                auto ramp = Vec::add(base, Vec::mul(steps, stepVec));
+                Vec::store(dest + sample, Vec::mul(Vec::load(dest + sample), ramp));
+            }
+
+            for (; sample < end; sample++) {
+                dest[sample] *= start + step * static_cast<SampleType>(sample - offset + 1);
+            }
+
+            start = target;
+        }
+    }
+
+    static auto processStreams(const StreamLanes<SampleType>& lanes, const SampleType* inputL, const SampleType* inputR,
+        SampleType* outputL, SampleType* outputR, int numStreams, int numSamples) -> void {
+        for (int sample = 0; sample < numSamples; sample++) {
+            auto frame = static_cast<size_t>(sample) * static_cast<size_t>(numStreams);
+            int stream = 0;
+
+            for (; stream + width <= numStreams; stream += width) {
+                processLanes<Vec>(lanes, static_cast<size_t>(stream), frame, inputL, inputR, outputL, outputR);
+            }
+
+            // Leftover streams take the same arithmetic one at a time
+            for (; stream < numStreams; stream++) {
+                processLanes<Scalar>(lanes, static_cast<size_t>(stream), frame, inputL, inputR, outputL, outputR);
+            }
+        }
+    }
+
+private:
+    using Ramp = typename StreamLanes<SampleType>::Ramp;
+
+    template <typename V>
+    static inline auto processLanes(const StreamLanes<SampleType>& lanes, size_t stream, size_t frame, const SampleType* inputL,
+        const SampleType* inputR, SampleType* outputL, SampleType* outputR) -> void {
+        auto zero = V::set1(SampleType(0));
+        auto one = V::set1(SampleType(1));
+        auto half = V::set1(SampleType(0.5));
+        auto maxBoost = V::set1(lanes.maxBoost);
+
+        auto gain = curveValue<V>(nextRampValue<V>(lanes.gain, stream), V::load(lanes.gainCurve + stream));
+        auto boost = nextRampValue<V>(lanes.boost, stream);
+        auto pan = nextRampValue<V>(lanes.pan, stream);
+        auto gainLFOAmount = nextRampValue<V>(lanes.gainLFOAmount, stream);
+        auto panLFOAmount = nextRampValue<V>(lanes.panLFOAmount, stream);
+        auto gainLFO = nextLFOValue<V>(lanes.gainLFOPhase, lanes.gainLFOIncrement, lanes.gainLFOShape, stream);
+        auto panLFO = nextLFOValue<V>(lanes.panLFOPhase, lanes.panLFOIncrement, lanes.panLFOShape, stream);
+
+        // Same as Curves::applyLFO, the bipolar LFO maps onto [1 - amount, 1]
+        gain = V::mul(gain, V::sub(one, V::mul(V::mul(gainLFOAmount, V::sub(one, gainLFO)), half)));
+
+        auto boostdB = V::min(V::max(boost, zero), maxBoost);
+        auto curvedBoost = V::mul(curveValue<V>(V::div(boostdB, maxBoost), V::load(lanes.boostCurve + stream)), maxBoost);
+        gain = V::mul(gain, boostGain<V>(curvedBoost));
+
+        pan = V::add(pan, V::mul(V::mul(panLFO, panLFOAmount), half));
+        pan = V::min(V::max(pan, V::set1(SampleType(-1))), one);
+
+        auto [panL, panR] = panGains<V>(pan, V::load(lanes.panningLaw + stream));
+        auto index = frame + stream;
+
+        V::store(outputL + index, V::mul(V::mul(V::load(inputL + index), gain), panL));
+        V::store(outputR + index, V::mul(V::mul(V::load(inputR + index), gain), panR));
+    }
+
+    // One sample of a register of ramps, same countdown as Smoother::getNextValue
+    template <typename V>
+    static inline auto nextRampValue(const Ramp& ramp, size_t stream) -> typename V::Register {
+        auto zero = V::set1(SampleType(0));
+        auto remaining = V::load(ramp.remaining + stream);
+        auto current = V::load(ramp.current + stream);
+        auto active = V::cmpgt(remaining, zero);
+
+        remaining = V::select(active, V::sub(remaining, V::set1(SampleType(1))), remaining);
+        auto stepped = V::select(V::cmpgt(remaining, zero), V::add(current, V::load(ramp.step + stream)), V::load(ramp.target + stream));
+        current = V::select(active, stepped, current);
+
+        V::store(ramp.remaining + stream, remaining);
+        V::store(ramp.current + stream, current);
+        return current;
+    }
+
+    // Lanes holding option, enum values are small integers stored as SampleType
+    template <typename V, typename Enum>
+    static inline auto isOption(typename V::Register value, Enum option) -> typename V::Mask {
+        auto index = static_cast<SampleType>(option);
+        return V::maskAnd(V::cmpgt(value, V::set1(index - SampleType(0.5))), V::cmplt(value, V::set1(index + SampleType(0.5))));
+    }
+
+    template <typename V>
+    static inline auto curveValue(typename V::Register value, typename V::Register curve) -> typename V::Register {
+        auto curved = V::select(isOption<V>(curve, ResponseCurve::logarithmic), V::sqrt(value), value);
+        return V::select(isOption<V>(curve, ResponseCurve::exponential), V::mul(value, value), curved);
+    }
+
+    // Phase inverted like the plugin's LFOs, the phase then advances one sample
+    template <typename V>
+    static inline auto nextLFOValue(SampleType* phases, const SampleType* increments, const SampleType* shapes, 
+        size_t stream) -> typename V::Register {
+        auto phase = V::load(phases + stream);
+        auto shape = V::load(shapes + stream);
+
+        auto value = V::select(isOption<V>(shape, LFOShape::saw), shapeValue<LFOShape::saw>(phase), shapeValue<LFOShape::square>(phase));
+        value = V::select(isOption<V>(shape, LFOShape::triangle), shapeValue<LFOShape::triangle>(phase), value);
+
+        auto sine = isOption<V>(shape, LFOShape::sine);
+        if (V::countMask(sine) > 0) value = V::select(sine, sineValue<V>(phase), value);
+
+        auto one = V::set1(SampleType(1));
+        auto next = V::add(phase, V::load(increments + stream));
+        V::store(phases + stream, V::select(V::cmplt(next, one), next, V::sub(next, one)));
+
+        return V::mul(value, V::set1(SampleType(-1)));
+    }
+
+    // 10^(dB / 20) over the boost range, written as 2^x = (sqrt(2) * e^y)^2 with y = (x / 2 - 1 / 2) ln 2.
+    // Up to 12 dB y stays within [-0.35, 0.35], where the degree 9 Taylor series is within 1e-11
+    template <typename V>
+    static inline auto boostGain(typename V::Register decibels) -> typename V::Register {
+        auto log2Of10Over40 = static_cast<SampleType>(0.083048202372184058696757985737);
+        auto ln2 = static_cast<SampleType>(0.69314718055994530941723212145818);
+        auto y = V::mul(V::sub(V::mul(decibels, V::set1(log2Of10Over40)), V::set1(SampleType(0.5))), V::set1(ln2));
+
+        auto poly = V::set1(static_cast<SampleType>(1.0 / 362880.0));
+        for (double factorial : {40320.0, 5040.0, 720.0, 120.0, 24.0, 6.0, 2.0, 1.0, 1.0}) {
+            poly = V::add(V::mul(poly, y), V::set1(static_cast<SampleType>(1.0 / factorial)));
+        }
+
+        auto root = V::mul(poly, V::set1(static_cast<SampleType>(1.4142135623730950488016887242097)));
+        return V::mul(root, root);
+    }
+
+    // Same laws as PanningLaw, constant power takes cos and sin of (pan + 1) pi / 4 from the polynomial sine
+    template <typename V>
+    static inline auto panGains(typename V::Register pan, typename V::Register law) 
+        -> std::pair<typename V::Register, typename V::Register> {
+        auto one = V::set1(SampleType(1));
+        auto two = V::set1(SampleType(2));
+        auto half = V::set1(SampleType(0.5));
+
+        auto position = V::mul(V::add(pan, one), half);
+        auto triangleL = V::min(one, V::mul(two, V::sub(one, position)));
+        auto triangleR = V::min(one, V::mul(two, position));
+
+        auto left = V::mul(half, V::sub(one, pan));
+        auto right = V::mul(half, V::add(one, pan));
+
+        auto constant = isOption<V>(law, PanLaw::constant);
+        if (V::countMask(constant) > 0) {
+            auto angle = V::mul(position, V::set1(SampleType(0.25)));
+            left = V::select(constant, sineValue<V>(V::add(angle, V::set1(SampleType(0.25)))), left);
+            right = V::select(constant, sineValue<V>(angle), right);
+        }
+
+        auto norm = V::div(one, V::sqrt(V::add(V::mul(left, left), V::mul(right, right))));
+        auto triangle = isOption<V>(law, PanLaw::triangle);
+        return {V::select(triangle, triangleL, V::mul(left, norm)), V::select(triangle, triangleR, V::mul(right, norm))};
+    }
+
+    static inline auto interleavedCoefficients(const SampleType* gain, const SampleType* panL, 
+        const SampleType* panR, int frame) -> std::pair<typename Vec::Register, typename Vec::Register> {
+        auto frameGain = Vec::load(gain + frame);
+        auto left = Vec::mul(frameGain, Vec::load(panL + frame));
+        auto right = Vec::mul(frameGain, Vec::load(panR + frame));
+        return {Vec::zipLow(left, right), Vec::zipHigh(left, right)};
+    }
+
+    static inline auto readInt24(const uint8_t* data) -> int32_t {
+        auto bits = static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16);
+        return static_cast<int32_t>(bits << 8) >> 8;
+    }
+
+    static inline auto writeInt24(uint8_t* data, SampleType value) -> void {
+        auto clamped = std::clamp(value, SampleType(-8388608), SampleType(8388607));
+        auto bits = static_cast<uint32_t>(static_cast<int32_t>(std::lrint(clamped)));
+        data[0] = static_cast<uint8_t>(bits);
+        data[1] = static_cast<uint8_t>(bits >> 8);
+        data[2] = static_cast<uint8_t>(bits >> 16);
+    }
+
+    template <LFOShape shape, typename Register>
+    static inline auto shapeValue(Register pos) -> Register {
+        using V = std::conditional_t<std::is_same_v<Register, SampleType>, Scalar, Vec>;
+
+        if constexpr (shape == LFOShape::square) {
+            return V::select(V::cmplt(pos, V::set1(SampleType(0.5))), V::set1(SampleType(1)), V::set1(SampleType(-1)));
+        } else if constexpr (shape == LFOShape::saw) {
+            return V::sub(V::mul(pos, V::set1(SampleType(2))), V::set1(SampleType(1)));
+        } else if constexpr (shape == LFOShape::sine) {
+            return sineValue<V>(pos);
+        } else {
+            auto distance = V::abs(V::sub(pos, V::set1(SampleType(0.5))));
+            return V::sub(V::mul(distance, V::set1(SampleType(4))), V::set1(SampleType(1)));
+        }
+    }
+
+    template <LFOShape shape>
+    static auto renderShape(SampleType* dest, SampleType phase, SampleType increment, bool invert, int numSamples) -> SampleType {
+        auto sign = invert ? SampleType(-1) : SampleType(1);
+        auto signVec = Vec::set1(sign);
+        auto offsets = Vec::mul(Vec::ramp(), Vec::set1(increment));
+        auto chunkIncrement = increment * static_cast<SampleType>(width);
+        int sample = 0;
+
+        for (; sample + width <= numSamples; sample += width) {
+            auto pos = Vec::fract(Vec::add(Vec::set1(phase), offsets));
+            Vec::store(dest + sample, Vec::mul(shapeValue<shape>(pos), signVec));
+
+            phase += chunkIncrement;
+            phase -= std::floor(phase);
+        }
+
+        for (; sample < numSamples; sample++) {
+            dest[sample] = shapeValue<shape>(phase) * sign;
+
+            phase += increment;
+            if (phase >= SampleType(1)) phase -= SampleType(1);
+        }
+
+        return phase;
+    }
+
+    // Residual of a unit step at phase zero, spread over one increment either side of the edge
+    template <typename V, typename Register>
+    static inline auto polyBLEP(Register pos, Register dt, Register inverseDt) -> Register {
+        auto one = V::set1(SampleType(1));
+        auto early = V::mul(pos, inverseDt);
+        auto late = V::mul(V::sub(pos, one), inverseDt);
+
+        auto rising = V::sub(V::sub(V::add(early, early), V::mul(early, early)), one);
+        auto falling = V::add(V::add(V::mul(late, late), V::add(late, late)), one);
+        auto tail = V::select(V::cmpgt(pos, V::sub(one, dt)), falling, V::set1(SampleType(0)));
+        return V::select(V::cmplt(pos, dt), rising, tail);
+    }
+
+    // Residual of a unit change of slope per sample at phase zero, the integral of the polyBLEP residual
+    template <typename V, typename Register>
+    static inline auto polyBLAMP(Register pos, Register dt, Register inverseDt) -> Register {
+        auto one = V::set1(SampleType(1));
+        auto sixth = V::set1(SampleType(1) / SampleType(6));
+        auto early = V::sub(one, V::mul(pos, inverseDt));
+        auto late = V::add(V::mul(V::sub(pos, one), inverseDt), one);
+
+        auto rising = V::mul(V::mul(V::mul(early, early), early), sixth);
+        auto falling = V::mul(V::mul(V::mul(late, late), late), sixth);
+        auto tail = V::select(V::cmpgt(pos, V::sub(one, dt)), falling, V::set1(SampleType(0)));
+        return V::select(V::cmplt(pos, dt), rising, tail);
+    }
+
+    // sin(2 pi pos) folded onto a quarter cycle, the degree 9 polynomial is within 4e-6
+    template <typename V, typename Register>
+    static inline auto sineValue(Register pos) -> Register {
+        auto x = V::sub(pos, V::set1(SampleType(0.5)));
+        auto half = V::select(V::cmplt(x, V::set1(SampleType(0))), V::set1(SampleType(-0.5)), V::set1(SampleType(0.5)));
+        auto folded = V::select(V::cmpgt(V::abs(x), V::set1(SampleType(0.25))), V::sub(half, x), x);
+
+        auto theta = V::mul(folded, V::set1(static_cast<SampleType>(6.283185307179586476925286766559)));
+        auto theta2 = V::mul(theta, theta);
+        auto poly = V::set1(static_cast<SampleType>(1.0 / 362880.0));
+        poly = V::add(V::mul(poly, theta2), V::set1(static_cast<SampleType>(-1.0 / 5040.0)));
+        poly = V::add(V::mul(poly, theta2), V::set1(static_cast<SampleType>(1.0 / 120.0)));
+        poly = V::add(V::mul(poly, theta2), V::set1(static_cast<SampleType>(-1.0 / 6.0)));
+        poly = V::add(V::mul(poly, theta2), V::set1(SampleType(1)));
+
+        // sin(2 pi pos) = -sin(2 pi (pos - 0.5))
+        return V::mul(V::mul(poly, theta), V::set1(SampleType(-1)));
+    }
+
+    template <LFOShape shape, typename Register>
+    static inline auto bandlimitedValue(Register pos, Register dt, Register inverseDt) -> Register {
+        using V = std::conditional_t<std::is_same_v<Register, SampleType>, Scalar, Vec>;
+
+        if constexpr (shape == LFOShape::sine) {
+            return sineValue<V>(pos);
+        } else if constexpr (shape == LFOShape::saw) {
+            return V::sub(shapeValue<shape>(pos), polyBLEP<V>(pos, dt, inverseDt));
+        } else if constexpr (shape == LFOShape::triangle) {
+            // The slope flips between -4 and +4 per cycle at both corners, a change of 8 dt per sample
+            auto halfCycle = V::fract(V::add(pos, V::set1(SampleType(0.5))));
+            auto slopeChange = V::mul(dt, V::set1(SampleType(8)));
+            auto value = V::sub(shapeValue<shape>(pos), V::mul(slopeChange, polyBLAMP<V>(pos, dt, inverseDt)));
+            return V::add(value, V::mul(slopeChange, polyBLAMP<V>(halfCycle, dt, inverseDt)));
+        } else {
+            auto halfCycle = V::fract(V::add(pos, V::set1(SampleType(0.5))));
+            auto value = V::add(shapeValue<shape>(pos), polyBLEP<V>(pos, dt, inverseDt));
+            return V::sub(value, polyBLEP<V>(halfCycle, dt, inverseDt));
+        }
+    }
+
+    template <LFOShape shape>
+    static auto renderBandlimited(SampleType* dest, SampleType phase, SampleType increment, bool invert, int numSamples) -> SampleType {
+        // Edges need at least one sample either side, above half the sample rate only the naive shape is left
+        if (increment <= SampleType(0) || increment >= SampleType(0.5)) {
+            return renderShape<shape>(dest, phase, increment, invert, numSamples);
+        }
+
+        auto sign = invert ? SampleType(-1) : SampleType(1);
+        auto inverseDt = SampleType(1) / increment;
+        auto signVec = Vec::set1(sign);
+        auto dtVec = Vec::set1(increment);
+        auto inverseDtVec = Vec::set1(inverseDt);
+        auto offsets = Vec::mul(Vec::ramp(), dtVec);
+        auto chunkIncrement = increment * static_cast<SampleType>(width);
+        int sample = 0;
+
+        for (; sample + width <= numSamples; sample += width) {
+            auto pos = Vec::fract(Vec::add(Vec::set1(phase), offsets));
+            Vec::store(dest + sample, Vec::mul(bandlimitedValue<shape>(pos, dtVec, inverseDtVec), signVec));
+
+            phase += chunkIncrement;
+            phase -= std::floor(phase);
+        }
+
+        for (; sample < numSamples; sample++) {
+            dest[sample] = bandlimitedValue<shape>(phase, increment, inverseDt) * sign;
+
+            phase += increment;
+            if (phase >= SampleType(1)) phase -= SampleType(1);
+        }
+
+        return phase;
+    }
+};
+
+template <template <typename> typename Vec>
+auto makeKernelSet(KernelISA isa) -> KernelSet {
+    using FloatImpl = KernelsImpl<Vec<float>>;
+    using DoubleImpl = KernelsImpl<Vec<double>>;
+
+    return {
+        isa,
+        {&FloatImpl::applyGainPan, &FloatImpl::applyGainPanInterleaved, &FloatImpl::renderLFO, &FloatImpl::renderOscillator, &FloatImpl::measureBlock,
+            &FloatImpl::multiplyAdd, &FloatImpl::segmentPeaks, &FloatImpl::applySegmentRamps, &FloatImpl::processStreams},
+        {&DoubleImpl::applyGainPan, &DoubleImpl::applyGainPanInterleaved, &DoubleImpl::renderLFO, &DoubleImpl::renderOscillator, &DoubleImpl::measureBlock,
+            &DoubleImpl::multiplyAdd, &DoubleImpl::segmentPeaks, &DoubleImpl::applySegmentRamps, &DoubleImpl::processStreams},
+        {&FloatImpl::applyGainPanInt16, &FloatImpl::applyGainPanInt24}
+    };
+}
+
+}
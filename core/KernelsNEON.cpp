@@ -0,0 +1,101 @@
+#include "KernelsImpl.hpp"
+
+#if GAIN_BOOSTER_NEON_KERNELS
+#include <arm_neon.h>
+
+namespace {
+
+template <typename SampleType>
+struct NEONVec;
+
+template <>
+struct NEONVec<float> {
+    using Scalar = float;
+    using Register = float32x4_t;
+    using Mask = uint32x4_t;
+    static constexpr int width = 4;
+
+    static inline auto load(const float* data) -> Register { return vld1q_f32(data); }
+    static inline auto store(float* data, Register value) -> void { vst1q_f32(data, value); }
+    static inline auto set1(float value) -> Register { return vdupq_n_f32(value); }
+    static inline auto add(Register a, Register b) -> Register { return vaddq_f32(a, b); }
+    static inline auto sub(Register a, Register b) -> Register { return vsubq_f32(a, b); }
+    static inline auto mul(Register a, Register b) -> Register { return vmulq_f32(a, b); }
+    static inline auto abs(Register a) -> Register { return vabsq_f32(a); }
+    static inline auto max(Register a, Register b) -> Register { return vmaxq_f32(a, b); }
+    static inline auto min(Register a, Register b) -> Register { return vminq_f32(a, b); }
+    static inline auto div(Register a, Register b) -> Register { return vdivq_f32(a, b); }
+    static inline auto sqrt(Register a) -> Register { return vsqrtq_f32(a); }
+    static inline auto cmplt(Register a, Register b) -> Mask { return vcltq_f32(a, b); }
+    static inline auto cmpgt(Register a, Register b) -> Mask { return vcgtq_f32(a, b); }
+    static inline auto maskAnd(Mask a, Mask b) -> Mask { return vandq_u32(a, b); }
+    static inline auto select(Mask mask, Register a, Register b) -> Register { return vbslq_f32(mask, a, b); }
+    static inline auto countMask(Mask mask) -> int { return static_cast<int>(vaddvq_u32(vshrq_n_u32(mask, 31))); }
+    static inline auto fract(Register a) -> Register { return vsubq_f32(a, vrndmq_f32(a)); }
+    static inline auto hmax(Register a) -> float { return vmaxvq_f32(a); }
+    static inline auto zipLow(Register a, Register b) -> Register { return vzip1q_f32(a, b); }
+    static inline auto zipHigh(Register a, Register b) -> Register { return vzip2q_f32(a, b); }
+    static inline auto loadInt16(const int16_t* data) -> Register { return vcvtq_f32_s32(vmovl_s16(vld1_s16(data))); }
+    static inline auto storeInt16(int16_t* data, Register value) -> void { vst1_s16(data, vqmovn_s32(vcvtnq_s32_f32(value))); }
+
+    static inline auto ramp() -> Register {
+        static const float values[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+        return vld1q_f32(values);
+    }
+
+    static inline auto isFinite(Register a) -> Mask {
+        auto exponent = vdupq_n_u32(0x7f800000u);
+        auto bits = vandq_u32(vreinterpretq_u32_f32(a), exponent);
+        return vmvnq_u32(vceqq_u32(bits, exponent));
+    }
+};
+
+template <>
+struct NEONVec<double> {
+    using Scalar = double;
+    using Register = float64x2_t;
+    using Mask = uint64x2_t;
+    static constexpr int width = 2;
+
+    static inline auto load(const double* data) -> Register { return vld1q_f64(data); }
+    static inline auto store(double* data, Register value) -> void { vst1q_f64(data, value); }
+    static inline auto set1(double value) -> Register { return vdupq_n_f64(value); }
+    static inline auto add(Register a, Register b) -> Register { return vaddq_f64(a, b); }
+    static inline auto sub(Register a, Register b) -> Register { return vsubq_f64(a, b); }
+    static inline auto mul(Register a, Register b) -> Register { return vmulq_f64(a, b); }
+    static inline auto abs(Register a) -> Register { return vabsq_f64(a); }
+    static inline auto max(Register a, Register b) -> Register { return vmaxq_f64(a, b); }
+    static inline auto min(Register a, Register b) -> Register { return vminq_f64(a, b); }
+    static inline auto div(Register a, Register b) -> Register { return vdivq_f64(a, b); }
+    static inline auto sqrt(Register a) -> Register { return vsqrtq_f64(a); }
+    static inline auto cmplt(Register a, Register b) -> Mask { return vcltq_f64(a, b); }
+    static inline auto cmpgt(Register a, Register b) -> Mask { return vcgtq_f64(a, b); }
+    static inline auto maskAnd(Mask a, Mask b) -> Mask { return vandq_u64(a, b); }
+    static inline auto select(Mask mask, Register a, Register b) -> Register { return vbslq_f64(mask, a, b); }
+    static inline auto countMask(Mask mask) -> int { return static_cast<int>(vaddvq_u64(vshrq_n_u64(mask, 63))); }
+    static inline auto fract(Register a) -> Register { return vsubq_f64(a, vrndmq_f64(a)); }
+    static inline auto hmax(Register a) -> double { return vmaxvq_f64(a); }
+    static inline auto zipLow(Register a, Register b) -> Register { return vzip1q_f64(a, b); }
+    static inline auto zipHigh(Register a, Register b) -> Register { return vzip2q_f64(a, b); }
+
+    static inline auto ramp() -> Register {
+        static const double values[2] = {0.0, 1.0};
+        return vld1q_f64(values);
+    }
+
+    static inline auto isFinite(Register a) -> Mask {
+        auto exponent = vdupq_n_u64(0x7ff0000000000000ull);
+        auto bits = vandq_u64(vreinterpretq_u64_f64(a), exponent);
+        auto equal = vreinterpretq_u32_u64(vceqq_u64(bits, exponent));
+        return vreinterpretq_u64_u32(vmvnq_u32(equal));
+    }
+};
+
+}
+
+auto getNEONKernels() -> const KernelSet& {
+    static const auto kernels = makeKernelSet<NEONVec>(KernelISA::neon);
+    return kernels;
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "KernelsImpl.hpp"
+
+#if GAIN_BOOSTER_X86_KERNELS
+#include <emmintrin.h>
+
+namespace {
+
+template <typename SampleType>
+struct SSE2Vec;
+
+template <>
+struct SSE2Vec<float> {
+    using Scalar = float;
+    using Register = __m128;
+    using Mask = __m128;
+    static constexpr int width = 4;
+
+    static inline auto load(const float* data) -> Register { return _mm_loadu_ps(data); }
+    static inline auto store(float* data, Register value) -> void { _mm_storeu_ps(data, value); }
+    static inline auto set1(float value) -> Register { return _mm_set1_ps(value); }
+    static inline auto ramp() -> Register { return _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f); }
+    static inline auto add(Register a, Register b) -> Register { return _mm_add_ps(a, b); }
+    static inline auto sub(Register a, Register b) -> Register { return _mm_sub_ps(a, b); }
+    static inline auto mul(Register a, Register b) -> Register { return _mm_mul_ps(a, b); }
+    static inline auto abs(Register a) -> Register { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static inline auto max(Register a, Register b) -> Register { return _mm_max_ps(a, b); }
+    static inline auto min(Register a, Register b) -> Register { return _mm_min_ps(a, b); }
+    static inline auto div(Register a, Register b) -> Register { return _mm_div_ps(a, b); }
+    static inline auto sqrt(Register a) -> Register { return _mm_sqrt_ps(a); }
+    static inline auto cmplt(Register a, Register b) -> Mask { return _mm_cmplt_ps(a, b); }
+    static inline auto cmpgt(Register a, Register b) -> Mask { return _mm_cmpgt_ps(a, b); }
+    static inline auto maskAnd(Mask a, Mask b) -> Mask { return _mm_and_ps(a, b); }
+    static inline auto select(Mask mask, Register a, Register b) -> Register { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static inline auto countMask(Mask mask) -> int { return std::popcount(static_cast<unsigned>(_mm_movemask_ps(mask))); }
+    static inline auto fract(Register a) -> Register { return _mm_sub_ps(a, _mm_cvtepi32_ps(_mm_cvttps_epi32(a))); }
+    static inline auto zipLow(Register a, Register b) -> Register { return _mm_unpacklo_ps(a, b); }
+    static inline auto zipHigh(Register a, Register b) -> Register { return _mm_unpackhi_ps(a, b); }
+
+    static inline auto loadInt16(const int16_t* data) -> Register {
+        auto values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+        return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16));
+    }
+
+    static inline auto storeInt16(int16_t* data, Register value) -> void {
+        auto rounded = _mm_cvtps_epi32(value);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(data), _mm_packs_epi32(rounded, rounded));
+    }
+
+    static inline auto isFinite(Register a) -> Mask {
+        auto exponent = _mm_set1_epi32(0x7f800000);
+        auto bits = _mm_and_si128(_mm_castps_si128(a), exponent);
+        return _mm_castsi128_ps(_mm_xor_si128(_mm_cmpeq_epi32(bits, exponent), _mm_set1_epi32(-1)));
+    }
+
+    static inline auto hmax(Register a) -> float {
+        auto upper = _mm_max_ps(a, _mm_movehl_ps(a, a));
+        return _mm_cvtss_f32(_mm_max_ss(upper, _mm_shuffle_ps(upper, upper, 1)));
+    }
+};
+
+template <>
+struct SSE2Vec<double> {
+    using Scalar = double;
+    using Register = __m128d;
+    using Mask = __m128d;
+    static constexpr int width = 2;
+
+    static inline auto load(const double* data) -> Register { return _mm_loadu_pd(data); }
+    static inline auto store(double* data, Register value) -> void { _mm_storeu_pd(data, value); }
+    static inline auto set1(double value) -> Register { return _mm_set1_pd(value); }
+    static inline auto ramp() -> Register { return _mm_setr_pd(0.0, 1.0); }
+    static inline auto add(Register a, Register b) -> Register { return _mm_add_pd(a, b); }
+    static inline auto sub(Register a, Register b) -> Register { return _mm_sub_pd(a, b); }
+    static inline auto mul(Register a, Register b) -> Register { return _mm_mul_pd(a, b); }
+    static inline auto abs(Register a) -> Register { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static inline auto max(Register a, Register b) -> Register { return _mm_max_pd(a, b); }
+    static inline auto min(Register a, Register b) -> Register { return _mm_min_pd(a, b); }
+    static inline auto div(Register a, Register b) -> Register { return _mm_div_pd(a, b); }
+    static inline auto sqrt(Register a) -> Register { return _mm_sqrt_pd(a); }
+    static inline auto cmplt(Register a, Register b) -> Mask { return _mm_cmplt_pd(a, b); }
+    static inline auto cmpgt(Register a, Register b) -> Mask { return _mm_cmpgt_pd(a, b); }
+    static inline auto maskAnd(Mask a, Mask b) -> Mask { return _mm_and_pd(a, b); }
+    static inline auto select(Mask mask, Register a, Register b) -> Register { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+    static inline auto countMask(Mask mask) -> int { return std::popcount(static_cast<unsigned>(_mm_movemask_pd(mask))); }
+    static inline auto fract(Register a) -> Register { return _mm_sub_pd(a, _mm_cvtepi32_pd(_mm_cvttpd_epi32(a))); }
+    static inline auto zipLow(Register a, Register b) -> Register { return _mm_unpacklo_pd(a, b); }
+    static inline auto zipHigh(Register a, Register b) -> Register { return _mm_unpackhi_pd(a, b); }
+
+    static inline auto isFinite(Register a) -> Mask {
+        // SSE2 has no 64-bit compare, so the exponent test runs on the high 32-bit halves
+        auto exponent = _mm_set1_epi64x(0x7ff0000000000000ll);
+        auto bits = _mm_and_si128(_mm_castpd_si128(a), exponent);
+        auto equal = _mm_cmpeq_epi32(bits, exponent);
+        auto high = _mm_shuffle_epi32(equal, _MM_SHUFFLE(3, 3, 1, 1));
+        return _mm_castsi128_pd(_mm_xor_si128(high, _mm_set1_epi32(-1)));
+    }
+
+    static inline auto hmax(Register a) -> double {
+        return _mm_cvtsd_f64(_mm_max_sd(a, _mm_unpackhi_pd(a, a)));
+    }
+};
+
+}
+
+auto getSSE2Kernels() -> const KernelSet& {
+    static const auto kernels = makeKernelSet<SSE2Vec>(KernelISA::sse2);
+    return kernels;
+}
+
+#endif
@@ -0,0 +1,290 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "Kernels.h"
+#include "StreamParameters.hpp"
+
+/*
+ * The stream's tempo-synced LFOs and the routings between them. Per-LFO state is stored
+ * structure-of-arrays, each block every live LFO renders through the kernel table into one
+ * contiguous output buffer, and each audio-rate routing is a single multiplyAdd over the block.
+ * Cost grows by one kernel call per live LFO and per routing, nothing is dispatched per sample.
+ *
+ * The kernels vectorise along samples, not across LFOs. Only four LFOs exist
+ * (StreamParameters::numLFOs), so a register across them would fill half of an AVX2 register and a
+ * quarter of an AVX-512 one. Every sample would also have to evaluate all four shapes and scatter
+ * each value to its own output row. Along a block, every lane renders one shape and the stores
+ * stay contiguous.
+ *
+ * Gain, boost and pan routings are applied per sample. Routings to an LFO's rate or amount are
+ * control rate, they read each source's last value from the previous block.
+ *
+ * An LFO given a frequency runs free at that rate in Hz instead of tempo synced, and renders
+ * through the band-limited renderOscillator kernel so it can run at audio rates.
+ *
+ * When the host transport jumps, every synced LFO is realigned to the new position so it stays
+ * on the bar grid after a loop or seek.
+ */
+template <typename SampleType>
+class ModulationMatrix {
+public:
+    static constexpr size_t numLFOs = StreamParameters::numLFOs;
+    static constexpr size_t numRoutings = StreamParameters::numRoutings;
+
+    // Routing destinations are these indices plus one, zero is off
+    enum Destination : size_t {
+        gain,
+        boost,
+        pan,
+        numAudioDestinations
+    };
+
+    static constexpr size_t firstRateDestination = numAudioDestinations;
+    static constexpr size_t firstAmountDestination = firstRateDestination + numLFOs;
+    static constexpr size_t numDestinations = firstAmountDestination + numLFOs;
+
+    auto prepare(double newSampleRate, int maxBlockSize) -> void {
+        this->sampleRate = newSampleRate;
+        this->blockSize = static_cast<size_t>(std::max(1, maxBlockSize));
+
+        this->outputs.assign(numLFOs * this->blockSize, SampleType(0));
+        this->audio.assign(numAudioDestinations * this->blockSize, SampleType(0));
+        this->constantFilled.fill(false);
+
+        this->reset();
+        this->updateIncrements();
+    }
+
+    auto reset() -> void {
+        this->phase.fill(SampleType(0));
+        this->lastValue.fill(SampleType(0));
+        this->amountScale.fill(SampleType(1));
+    }
+
+    // Returns a bit per synced LFO that was realigned because the transport jumped
+    auto syncToHost(const Transport& transport, bool jumped) -> uint32_t {
+        // Four divisions, cheaper than tracking which of tempo and time signature changed
+        this->bpm = transport.bpm;
+        this->numerator = transport.numerator;
+        this->denominator = transport.denominator;
+        this->updateIncrements();
+
+        if (!jumped) return 0;
+        uint32_t retriggered = 0;
+
+        for (size_t lfo = 0; lfo < numLFOs; lfo++) {
+            if (this->frequency[lfo] > SampleType(0) || !(this->syncedRate[lfo] > SampleType(0))) continue;
+
+            double cycles = transport.ppq / static_cast<double>(this->syncedBeats(lfo));
+            this->phase[lfo] = static_cast<SampleType>(cycles - std::floor(cycles));
+            retriggered |= 1u << lfo;
+        }
+
+        return retriggered;
+    }
+
+    // A positive frequency in Hz runs the LFO free, otherwise it follows the synced rate
+    auto setLFO(size_t lfo, LFOShape newShape, SampleType newSyncedRate, SampleType newFrequency = SampleType(0)) -> void {
+        this->shape[lfo] = newShape;
+        if (!std::islessgreater(newSyncedRate, this->syncedRate[lfo]) && !std::islessgreater(newFrequency, this->frequency[lfo])) return;
+
+        this->syncedRate[lfo] = newSyncedRate;
+        this->frequency[lfo] = newFrequency;
+        this->baseIncrement[lfo] = this->getBaseIncrement(lfo);
+    }
+
+    auto setRoutings(const std::array<ModRouting, numRoutings>& routings) -> void {
+        for (auto& destination : this->destinations) destination.numRoutes = 0;
+
+        // The gain and pan LFOs always feed their fixed destinations
+        this->liveLFOs = 0b11;
+
+        for (const auto& routing : routings) {
+            if (routing.destination < 1 || routing.source < 0) continue;
+
+            auto index = static_cast<size_t>(routing.destination - 1);
+            auto source = static_cast<size_t>(routing.source);
+            if (index >= numDestinations || source >= numLFOs) continue;
+
+            // A zero depth routing is off, anything else counts even if tiny
+            if (!(std::abs(routing.depth) > 0.0f)) continue;
+
+            auto depth = static_cast<SampleType>(routing.depth);
+            auto& destination = this->destinations[index];
+            auto& route = destination.routes[destination.numRoutes++];
+            route.source = source;
+
+            // Gain and amounts dip from full like the gain LFO, boost rises from the set boost,
+            // pan swings around the set pan and rate bends by up to an octave either way
+            if (index == Destination::gain || index >= firstAmountDestination) {
+                route.bias = -std::abs(depth) * SampleType(0.5);
+                route.scale = depth * SampleType(0.5);
+            } else if (index == Destination::boost) {
+                route.scale = depth * static_cast<SampleType>(Curves::maxBoost) * SampleType(0.5);
+                route.bias = route.scale;
+            } else if (index == Destination::pan) {
+                route.bias = SampleType(0);
+                route.scale = depth * SampleType(0.5);
+            } else {
+                route.bias = SampleType(0);
+                route.scale = depth;
+            }
+
+            this->liveLFOs |= 1u << source;
+        }
+    }
+
+    auto render(int numSamples, const KernelTable<SampleType>& kernels) -> void {
+        std::array<SampleType, numLFOs> nextAmountScale;
+
+        for (size_t lfo = 0; lfo < numLFOs; lfo++) {
+            const auto& rate = this->destinations[firstRateDestination + lfo];
+            auto octaves = this->evaluate(rate, SampleType(0));
+            this->increment[lfo] = rate.numRoutes > 0 ? this->baseIncrement[lfo] * std::exp2(octaves) : this->baseIncrement[lfo];
+
+            const auto& amount = this->destinations[firstAmountDestination + lfo];
+            nextAmountScale[lfo] = std::max(SampleType(0), this->evaluate(amount, SampleType(1)));
+        }
+
+        this->amountScale = nextAmountScale;
+
+        for (size_t lfo = 0; lfo < numLFOs; lfo++) {
+            if ((this->liveLFOs & (1u << lfo)) == 0) {
+                auto advanced = this->phase[lfo] + this->increment[lfo] * static_cast<SampleType>(numSamples);
+                this->phase[lfo] = advanced - std::floor(advanced);
+                continue;
+            }
+
+            auto* output = this->getOutput(lfo);
+            auto renderKernel = this->frequency[lfo] > SampleType(0) ? kernels.renderOscillator : kernels.renderLFO;
+            this->phase[lfo] = renderKernel(output, this->phase[lfo], this->increment[lfo], this->shape[lfo], true, numSamples);
+            if (numSamples > 0) this->lastValue[lfo] = output[numSamples - 1];
+        }
+
+        for (size_t index = 0; index < numAudioDestinations; index++) {
+            const auto& destination = this->destinations[index];
+            auto* dest = this->audio.data() + index * this->blockSize;
+            auto base = index == Destination::gain ? SampleType(1) : SampleType(0);
+
+            // Unrouted destinations keep their constant buffer, so they cost nothing per block
+            if (destination.numRoutes == 0) {
+                if (!this->constantFilled[index]) std::fill_n(dest, this->blockSize, base);
+                this->constantFilled[index] = true;
+                continue;
+            }
+
+            this->constantFilled[index] = false;
+            SampleType offset = base;
+
+            for (size_t i = 0; i < destination.numRoutes; i++) {
+                const auto& route = destination.routes[i];
+                offset += route.bias * this->amountScale[route.source];
+            }
+
+            std::fill_n(dest, numSamples, offset);
+
+            for (size_t i = 0; i < destination.numRoutes; i++) {
+                const auto& route = destination.routes[i];
+                kernels.multiplyAdd(dest, this->getOutput(route.source), route.scale * this->amountScale[route.source], numSamples);
+            }
+        }
+    }
+
+    // Bipolar, phase inverted LFO output for the last rendered block
+    auto getOutput(size_t lfo) -> SampleType* {
+        return this->outputs.data() + lfo * this->blockSize;
+    }
+
+    // Per-sample gain factor, boost offset in dB or pan offset for the last rendered block
+    auto getDestination(Destination destination) const -> const SampleType* {
+        return this->audio.data() + static_cast<size_t>(destination) * this->blockSize;
+    }
+
+    // Control-rate factor on an LFO's amount, one when nothing is routed to it
+    auto getAmountScale(size_t lfo) const -> SampleType {
+        return this->amountScale[lfo];
+    }
+
+    auto getPhase(size_t lfo) const -> SampleType {
+        return this->phase[lfo];
+    }
+
+    auto getIncrement(size_t lfo) const -> SampleType {
+        return this->increment[lfo];
+    }
+
+private:
+    struct Route {
+        size_t source = 0;
+        SampleType bias = SampleType(0);
+        SampleType scale = SampleType(0);
+    };
+
+    struct Routes {
+        size_t numRoutes = 0;
+        std::array<Route, numRoutings> routes{};
+    };
+
+    double sampleRate = 44100.0;
+    double bpm = 150.0;
+    int numerator = 4;
+    int denominator = 4;
+    size_t blockSize = 512;
+
+    std::array<LFOShape, numLFOs> shape{};
+    std::array<SampleType, numLFOs> syncedRate{};
+    std::array<SampleType, numLFOs> frequency{};
+    std::array<SampleType, numLFOs> baseIncrement{};
+    std::array<SampleType, numLFOs> increment{};
+    std::array<SampleType, numLFOs> phase{};
+    std::array<SampleType, numLFOs> lastValue{};
+    std::array<SampleType, numLFOs> amountScale{};
+    uint32_t liveLFOs = 0b11;
+
+    std::array<Routes, numDestinations> destinations{};
+    std::array<bool, numAudioDestinations> constantFilled{};
+    std::vector<SampleType> outputs;
+    std::vector<SampleType> audio;
+
+    auto evaluate(const Routes& destination, SampleType base) const -> SampleType {
+        SampleType value = base;
+
+        for (size_t i = 0; i < destination.numRoutes; i++) {
+            const auto& route = destination.routes[i];
+            value += (route.bias + route.scale * this->lastValue[route.source]) * this->amountScale[route.source];
+        }
+
+        return value;
+    }
+
+    auto syncedBeats(size_t lfo) const -> SampleType {
+        auto timeScale = static_cast<SampleType>(this->numerator) / static_cast<SampleType>(this->denominator);
+        return this->syncedRate[lfo] * SampleType(4) * timeScale;
+    }
+
+    // Same arithmetic the per-sample LFO used, so existing sessions keep their timing
+    auto getSyncedIncrement(SampleType rate) const -> SampleType {
+        auto timeScale = static_cast<SampleType>(this->numerator) / static_cast<SampleType>(this->denominator);
+        auto beats = rate * SampleType(4) * timeScale;
+
+        double beatDuration = 60.0 / this->bpm;
+        double syncedSamples = static_cast<double>(beats) * beatDuration * this->sampleRate;
+        return SampleType(1) / static_cast<SampleType>(syncedSamples);
+    }
+
+    auto getBaseIncrement(size_t lfo) const -> SampleType {
+        if (this->frequency[lfo] > SampleType(0)) {
+            return this->frequency[lfo] / static_cast<SampleType>(this->sampleRate);
+        }
+        return this->syncedRate[lfo] > SampleType(0) ? this->getSyncedIncrement(this->syncedRate[lfo]) : SampleType(0);
+    }
+
+    auto updateIncrements() -> void {
+        for (size_t lfo = 0; lfo < numLFOs; lfo++) {
+            this->baseIncrement[lfo] = this->getBaseIncrement(lfo);
+        }
+    }
+};
@@ -0,0 +1,136 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+// One decimated column of the rendered modulation, LFO phases are taken at the column's last sample
+struct ScopeColumn {
+    float gainMin;
+    float gainMax;
+    float panMin;
+    float panMax;
+    float gainLFOPhase;
+    float panLFOPhase;
+};
+
+/*
+ * Min/max summary of the per-sample gain and pan coefficients for the editor's modulation display.
+ * The audio thread folds each block into columns of samplesPerColumn samples and pushes finished
+ * columns into a single producer, single consumer ring, the editor drains it. Nothing allocates,
+ * and while disabled (no editor open) addBlock is never called.
+ */
+class ModulationScope {
+public:
+    static constexpr int capacity = 1024;
+    static constexpr double columnsPerSecond = 240.0;
+
+    auto prepare(double sampleRate) -> void {
+        this->samplesPerColumn = std::max(1, static_cast<int>(std::lround(sampleRate / ModulationScope::columnsPerSecond)));
+        this->columnRate.store(sampleRate / this->samplesPerColumn, std::memory_order_relaxed);
+        this->startColumn();
+    }
+
+    auto setEnabled(bool shouldBeEnabled) -> void {
+        this->enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+    }
+
+    auto isEnabled() const -> bool {
+        return this->enabled.load(std::memory_order_relaxed);
+    }
+
+    auto getColumnRate() const -> double {
+        return this->columnRate.load(std::memory_order_relaxed);
+    }
+
+    // Phases and increments are the LFO states after the block, earlier column phases are stepped back from them
+    template <typename SampleType>
+    auto addBlock(const SampleType* gain, const SampleType* pan, int numSamples, SampleType gainPhase,
+        SampleType gainIncrement, SampleType panPhase, SampleType panIncrement) noexcept -> void {
+        int offset = 0;
+
+        while (offset < numSamples) {
+            int count = std::min(numSamples - offset, this->samplesPerColumn - this->filled);
+            auto gainMin = static_cast<SampleType>(this->column.gainMin);
+            auto gainMax = static_cast<SampleType>(this->column.gainMax);
+            auto panMin = static_cast<SampleType>(this->column.panMin);
+            auto panMax = static_cast<SampleType>(this->column.panMax);
+
+            for (int sample = offset; sample < offset + count; sample++) {
+                gainMin = std::min(gainMin, gain[sample]);
+                gainMax = std::max(gainMax, gain[sample]);
+                panMin = std::min(panMin, pan[sample]);
+                panMax = std::max(panMax, pan[sample]);
+            }
+
+            this->column.gainMin = static_cast<float>(gainMin);
+            this->column.gainMax = static_cast<float>(gainMax);
+            this->column.panMin = static_cast<float>(panMin);
+            this->column.panMax = static_cast<float>(panMax);
+
+            this->filled += count;
+            offset += count;
+
+            if (this->filled == this->samplesPerColumn) {
+                auto remaining = static_cast<SampleType>(numSamples - offset);
+                this->column.gainLFOPhase = ModulationScope::wrapPhase(gainPhase - gainIncrement * remaining);
+                this->column.panLFOPhase = ModulationScope::wrapPhase(panPhase - panIncrement * remaining);
+                this->push(this->column);
+                this->startColumn();
+            }
+        }
+    }
+
+    // Message thread, returns the number of columns copied into dest
+    auto read(ScopeColumn* dest, int maxColumns) noexcept -> int {
+        auto start = this->readIndex.load(std::memory_order_relaxed);
+        auto available = this->writeIndex.load(std::memory_order_acquire) - start;
+        auto count = std::min(available, static_cast<uint32_t>(std::max(0, maxColumns)));
+
+        for (uint32_t i = 0; i < count; i++) {
+            dest[i] = this->columns[(start + i) & ModulationScope::mask];
+        }
+
+        this->readIndex.store(start + count, std::memory_order_release);
+        return static_cast<int>(count);
+    }
+
+    auto discard() noexcept -> void {
+        this->readIndex.store(this->writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    static constexpr uint32_t mask = ModulationScope::capacity - 1;
+    static_assert((ModulationScope::capacity & ModulationScope::mask) == 0, "capacity must be a power of two");
+
+    std::array<ScopeColumn, ModulationScope::capacity> columns{};
+    std::atomic<uint32_t> writeIndex{0};
+    std::atomic<uint32_t> readIndex{0};
+    std::atomic<double> columnRate{ModulationScope::columnsPerSecond};
+    std::atomic<bool> enabled{false};
+
+    ScopeColumn column{};
+    int samplesPerColumn = 1;
+    int filled = 0;
+
+    template <typename SampleType>
+    static auto wrapPhase(SampleType phase) -> float {
+        return static_cast<float>(phase - std::floor(phase));
+    }
+
+    auto startColumn() -> void {
+        this->column = {INFINITY, -INFINITY, INFINITY, -INFINITY, 0.0f, 0.0f};
+        this->filled = 0;
+    }
+
+    auto push(const ScopeColumn& value) noexcept -> void {
+        auto next = this->writeIndex.load(std::memory_order_relaxed);
+
+        // A reader that fell behind loses the newest columns rather than racing the writer
+        if (next - this->readIndex.load(std::memory_order_acquire) >= ModulationScope::capacity) return;
+
+        this->columns[next & ModulationScope::mask] = value;
+        this->writeIndex.store(next + 1, std::memory_order_release);
+    }
+};
@@ -0,0 +1,149 @@
+#include "MultiStreamProcessor.h"
+#include <algorithm>
+#include <cmath>
+
+// Exact comparison, setting the same value again must not restart a ramp or recompute increments
+template <typename T>
+static inline auto unchanged(T a, T b) -> bool {
+    return !(a < b) && !(b < a);
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::SmoothedLanes::resize(int numStreams) -> void {
+    for (auto* lane : {&this->current, &this->target, &this->step, &this->remaining}) {
+        lane->assign(static_cast<size_t>(numStreams), SampleType(0));
+    }
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::SmoothedLanes::setCurrentAndTarget(int stream, SampleType value) -> void {
+    auto index = static_cast<size_t>(stream);
+    this->current[index] = value;
+    this->target[index] = value;
+    this->remaining[index] = SampleType(0);
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::SmoothedLanes::setTarget(int stream, SampleType value, int stepsToTarget) -> void {
+    auto index = static_cast<size_t>(stream);
+    if (unchanged(value, this->target[index])) return;
+
+    if (stepsToTarget <= 0) {
+        this->setCurrentAndTarget(stream, value);
+        return;
+    }
+
+    this->target[index] = value;
+    this->remaining[index] = static_cast<SampleType>(stepsToTarget);
+    this->step[index] = (value - this->current[index]) / static_cast<SampleType>(stepsToTarget);
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::prepare(int streamCount, double newSampleRate, KernelISA isa) -> void {
+    this->numStreams = std::max(0, streamCount);
+    this->sampleRate = newSampleRate;
+    this->stepsToTarget = static_cast<int>(std::floor(MultiStreamProcessor::smoothingTime * this->sampleRate));
+    this->kernels = &Kernels::getTable<SampleType>(isa);
+
+    for (auto* lanes : {&this->gain, &this->boost, &this->pan, &this->gainLFOAmount, &this->panLFOAmount}) {
+        lanes->resize(this->numStreams);
+    }
+
+    auto perStream = {&this->gainCurve, &this->boostCurve, &this->panningLaw, &this->gainLFOShape, &this->panLFOShape,
+        &this->gainLFORate, &this->panLFORate, &this->gainLFOPhase, &this->panLFOPhase,
+        &this->gainLFOIncrement, &this->panLFOIncrement};
+
+    for (auto* values : perStream) {
+        values->assign(static_cast<size_t>(this->numStreams), SampleType(0));
+    }
+
+    for (int stream = 0; stream < this->numStreams; stream++) {
+        this->resetStream(stream, StreamParameters{});
+    }
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::getNumStreams() const -> int {
+    return this->numStreams;
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::resetStream(int stream, const StreamParameters& parameters) -> void {
+    this->gain.setCurrentAndTarget(stream, static_cast<SampleType>(parameters.gain));
+    this->boost.setCurrentAndTarget(stream, static_cast<SampleType>(parameters.boost));
+    this->pan.setCurrentAndTarget(stream, static_cast<SampleType>(parameters.pan));
+    this->gainLFOAmount.setCurrentAndTarget(stream, static_cast<SampleType>(parameters.gainLFOAmount));
+    this->panLFOAmount.setCurrentAndTarget(stream, static_cast<SampleType>(parameters.panLFOAmount));
+
+    auto index = static_cast<size_t>(stream);
+    this->gainLFOPhase[index] = SampleType(0);
+    this->panLFOPhase[index] = SampleType(0);
+
+    this->setParameters(stream, parameters);
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::setParameters(int stream, const StreamParameters& parameters) -> void {
+    this->gain.setTarget(stream, static_cast<SampleType>(parameters.gain), this->stepsToTarget);
+    this->boost.setTarget(stream, static_cast<SampleType>(parameters.boost), this->stepsToTarget);
+    this->pan.setTarget(stream, static_cast<SampleType>(parameters.pan), this->stepsToTarget);
+    this->gainLFOAmount.setTarget(stream, static_cast<SampleType>(parameters.gainLFOAmount), this->stepsToTarget);
+    this->panLFOAmount.setTarget(stream, static_cast<SampleType>(parameters.panLFOAmount), this->stepsToTarget);
+
+    auto index = static_cast<size_t>(stream);
+    this->gainCurve[index] = static_cast<SampleType>(parameters.gainCurve);
+    this->boostCurve[index] = static_cast<SampleType>(parameters.boostCurve);
+    this->panningLaw[index] = static_cast<SampleType>(parameters.panningLaw);
+    this->gainLFOShape[index] = static_cast<SampleType>(parameters.gainLFOType);
+    this->panLFOShape[index] = static_cast<SampleType>(parameters.panLFOType);
+
+    this->gainLFORate[index] = static_cast<SampleType>(parameters.gainLFORate);
+    this->panLFORate[index] = static_cast<SampleType>(parameters.panLFORate);
+    this->gainLFOIncrement[index] = this->getSyncedIncrement(this->gainLFORate[index]);
+    this->panLFOIncrement[index] = this->getSyncedIncrement(this->panLFORate[index]);
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::setTransport(const Transport& newTransport) -> void {
+    bool tempoChanged = !unchanged(newTransport.bpm, this->transport.bpm) || newTransport.numerator != this->transport.numerator
+        || newTransport.denominator != this->transport.denominator;
+
+    this->transport = newTransport;
+    if (!tempoChanged) return;
+
+    for (size_t index = 0; index < static_cast<size_t>(this->numStreams); index++) {
+        this->gainLFOIncrement[index] = this->getSyncedIncrement(this->gainLFORate[index]);
+        this->panLFOIncrement[index] = this->getSyncedIncrement(this->panLFORate[index]);
+    }
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::getSyncedIncrement(SampleType syncedRate) const -> SampleType {
+    // Same arithmetic as ModulationMatrix::getSyncedIncrement so both paths stay sample identical
+    auto timeScale = static_cast<SampleType>(this->transport.numerator) / static_cast<SampleType>(this->transport.denominator);
+    auto syncedBeats = syncedRate * SampleType(4) * timeScale;
+
+    double beatDuration = 60.0 / this->transport.bpm;
+    double syncedSamples = static_cast<double>(syncedBeats) * beatDuration * this->sampleRate;
+    return SampleType(1) / static_cast<SampleType>(syncedSamples);
+}
+
+template <typename SampleType>
+auto MultiStreamProcessor<SampleType>::process(const SampleType* inputL, const SampleType* inputR,
+    SampleType* outputL, SampleType* outputR, int numSamples) -> void {
+    auto ramp = [](SmoothedLanes& lanes) {
+        return typename StreamLanes<SampleType>::Ramp{lanes.current.data(), lanes.target.data(), lanes.step.data(), lanes.remaining.data()};
+    };
+
+    StreamLanes<SampleType> lanes{
+        ramp(this->gain), ramp(this->boost), ramp(this->pan), ramp(this->gainLFOAmount), ramp(this->panLFOAmount),
+        this->gainCurve.data(), this->boostCurve.data(), this->panningLaw.data(), this->gainLFOShape.data(), this->panLFOShape.data(),
+        this->gainLFOPhase.data(), this->panLFOPhase.data(), this->gainLFOIncrement.data(), this->panLFOIncrement.data(),
+        static_cast<SampleType>(Curves::maxBoost)
+    };
+
+    this->kernels->processStreams(lanes, inputL, inputR, outputL, outputR, this->numStreams, numSamples);
+}
+
+template class MultiStreamProcessor<float>;
+template class MultiStreamProcessor<double>;
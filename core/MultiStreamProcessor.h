@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include "Kernels.h"
+#include "StreamParameters.hpp"
+
+/*
+ * Processes many independent stereo streams in one call. Every piece of per-stream state
+ * (smoothers, LFO phase, curve selections) is stored structure-of-arrays and the processStreams
+ * kernel runs across streams, so SIMD lanes map to streams rather than to samples.
+ *
+ * Audio buffers are stream-interleaved: numSamples frames of numStreams samples,
+ * addressed as data[sample * numStreams + stream].
+ *
+ * Each stream follows StreamProcessor with the gain and pan LFOs only, the modulation matrix,
+ * audio-rate modes and ducking are not available here. Output is not bit identical: the LFO phase
+ * accumulates per sample, and sines, constant power panning and the boost curve come from
+ * polynomials. core/tests/MultiStreamTest.cpp holds it within 1e-5 of StreamProcessor.
+ */
+template <typename SampleType>
+class MultiStreamProcessor {
+public:
+    static constexpr double smoothingTime = 0.001;
+
+    auto prepare(int streamCount, double newSampleRate, KernelISA isa) -> void;
+    auto getNumStreams() const -> int;
+
+    auto resetStream(int stream, const StreamParameters& parameters) -> void;
+    auto setParameters(int stream, const StreamParameters& parameters) -> void;
+    auto setTransport(const Transport& newTransport) -> void;
+
+    auto process(const SampleType* inputL, const SampleType* inputR,
+        SampleType* outputL, SampleType* outputR, int numSamples) -> void;
+
+private:
+    struct SmoothedLanes {
+        std::vector<SampleType> current;
+        std::vector<SampleType> target;
+        std::vector<SampleType> step;
+        std::vector<SampleType> remaining;
+
+        auto resize(int numStreams) -> void;
+        auto setCurrentAndTarget(int stream, SampleType value) -> void;
+        auto setTarget(int stream, SampleType value, int stepsToTarget) -> void;
+    };
+
+    const KernelTable<SampleType>* kernels = &Kernels::getTable<SampleType>(KernelISA::scalar);
+    int numStreams = 0;
+    int stepsToTarget = 0;
+    double sampleRate = 44100.0;
+    Transport transport;
+
+    SmoothedLanes gain;
+    SmoothedLanes boost;
+    SmoothedLanes pan;
+    SmoothedLanes gainLFOAmount;
+    SmoothedLanes panLFOAmount;
+
+    // Enum selections stored as SampleType so the per-stream selects stay in one register type
+    std::vector<SampleType> gainCurve;
+    std::vector<SampleType> boostCurve;
+    std::vector<SampleType> panningLaw;
+    std::vector<SampleType> gainLFOShape;
+    std::vector<SampleType> panLFOShape;
+
+    std::vector<SampleType> gainLFORate;
+    std::vector<SampleType> panLFORate;
+    std::vector<SampleType> gainLFOPhase;
+    std::vector<SampleType> panLFOPhase;
+    std::vector<SampleType> gainLFOIncrement;
+    std::vector<SampleType> panLFOIncrement;
+
+    auto getSyncedIncrement(SampleType syncedRate) const -> SampleType;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cmath>
+#include "StreamParameters.hpp"
+
+class PanningLaw {
+public:
+    template <typename SampleType>
+    static inline auto apply(PanLaw law, SampleType pan, SampleType& panL, SampleType& panR) -> void {
+        switch (law) {
+            case PanLaw::triangle: return PanningLaw::trianglePanning(pan, panL, panR);
+            case PanLaw::linear: return PanningLaw::linearPanning(pan, panL, panR);
+            case PanLaw::constant: return PanningLaw::constantPowerPanning(pan, panL, panR);
+        }
+    }
+
+    template <typename SampleType>
+    static inline auto constantPowerPanning(SampleType pan, SampleType& panL, SampleType& panR) -> void {
+        SampleType angle = (pan + SampleType(1)) * static_cast<SampleType>(0.78539816339744830961566084581988);
+        panL = std::cos(angle);
+        panR = std::sin(angle);
+        SampleType norm = SampleType(1) / std::sqrt(panL * panL + panR * panR);
+        panL *= norm;
+        panR *= norm;
+    }
+
+    template <typename SampleType>
+    static inline auto trianglePanning(SampleType pan, SampleType& panL, SampleType& panR) -> void {
+        SampleType panPos = (pan + SampleType(1)) * SampleType(0.5);
+
+        if (panPos <= SampleType(0.5)) {
+            panL = SampleType(1);
+            panR = SampleType(2) * panPos;
+        } else {
+            panL = SampleType(2) * (SampleType(1) - panPos);
+            panR = SampleType(1);
+        }
+    }
+
+    template <typename SampleType>
+    static inline auto linearPanning(SampleType pan, SampleType& panL, SampleType& panR) -> void {
+        panL = SampleType(0.5) * (SampleType(1) - pan);
+        panR = SampleType(0.5) * (SampleType(1) + pan);
+        SampleType norm = SampleType(1) / std::sqrt(panL * panL + panR * panR);
+        panL *= norm;
+        panR *= norm;
+    }
+};
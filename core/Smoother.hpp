@@ -0,0 +1,58 @@
+#pragma once
+#include <cmath>
+
+// Linear ramp towards the target over a fixed number of samples, same behaviour as juce::LinearSmoothedValue
+template <typename SampleType>
+class Smoother {
+public:
+    auto reset(double sampleRate, double rampLengthInSeconds) -> void {
+        this->stepsToTarget = static_cast<int>(std::floor(rampLengthInSeconds * sampleRate));
+        this->setCurrentAndTargetValue(this->target);
+    }
+
+    auto setCurrentAndTargetValue(SampleType value) -> void {
+        this->current = value;
+        this->target = value;
+        this->countdown = 0;
+    }
+
+    auto setTargetValue(SampleType value) -> void {
+        if (!std::islessgreater(value, this->target)) return;
+
+        if (this->stepsToTarget <= 0) {
+            this->setCurrentAndTargetValue(value);
+            return;
+        }
+
+        this->target = value;
+        this->countdown = this->stepsToTarget;
+        this->step = (this->target - this->current) / static_cast<SampleType>(this->countdown);
+    }
+
+    auto getNextValue() -> SampleType {
+        if (this->countdown <= 0) return this->target;
+
+        this->countdown--;
+        this->current = this->countdown > 0 ? this->current + this->step : this->target;
+        return this->current;
+    }
+
+    auto getCurrentValue() const -> SampleType {
+        return this->current;
+    }
+
+    auto getTargetValue() const -> SampleType {
+        return this->target;
+    }
+
+    auto getStepsToTarget() const -> int {
+        return this->stepsToTarget;
+    }
+
+private:
+    SampleType current = SampleType(0);
+    SampleType target = SampleType(0);
+    SampleType step = SampleType(0);
+    int countdown = 0;
+    int stepsToTarget = 0;
+};
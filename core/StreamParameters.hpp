@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include "Kernels.h"
+
+// Synced follows the host tempo, tremolo and ring run the LFO free at an audio-capable rate in Hz.
+// Ring swings the gain through zero to a bipolar carrier at full amount
+enum class LFOMode {
+    synced,
+    tremolo,
+    ring
+};
+
+// One modulation matrix slot. Sources are LFO indices, destinations follow the plugin's choice order:
+// off, gain, boost, pan, then every LFO's rate, then every LFO's amount
+struct ModRouting {
+    int source = 0;
+    int destination = 0;
+    float depth = 0.0f;
+};
+
+struct StreamParameters {
+    // LFO 1 and 2 are the gain and pan LFOs, the rest only reach the signal through the matrix
+    static constexpr int numLFOs = 4;
+    static constexpr int numRoutings = 4;
+
+    float gain = 1.0f;
+    ResponseCurve gainCurve = ResponseCurve::linear;
+    float boost = 0.0f;
+    ResponseCurve boostCurve = ResponseCurve::linear;
+    float pan = 0.0f;
+    PanLaw panningLaw = PanLaw::triangle;
+
+    LFOShape gainLFOType = LFOShape::square;
+    float gainLFORate = 0.25f;
+    float gainLFOAmount = 0.0f;
+    LFOMode gainLFOMode = LFOMode::synced;
+    float gainLFOFrequency = 8.0f;
+
+    LFOShape panLFOType = LFOShape::square;
+    float panLFORate = 0.25f;
+    float panLFOAmount = 0.0f;
+
+    std::array<LFOShape, numLFOs - 2> auxLFOType{LFOShape::sine, LFOShape::sine};
+    std::array<float, numLFOs - 2> auxLFORate{0.25f, 0.25f};
+    std::array<ModRouting, numRoutings> routings{};
+
+    float duckAmount = 0.0f;
+    float duckAttack = 5.0f;
+    float duckRelease = 150.0f;
+};
+
+struct Transport {
+    double bpm = 150.0;
+    double ppq = 0.0;
+    int numerator = 4;
+    int denominator = 4;
+    bool isPlaying = false;
+    // False when the host reports no position, ppq is then advanced internally and never treated as a jump
+    bool hasPPQ = false;
+};
+
+class Curves {
+public:
+    static constexpr double maxBoost = 12.0;
+
+    template <typename SampleType>
+    static inline auto applyCurve(SampleType value, ResponseCurve curve) -> SampleType {
+        switch (curve) {
+            case ResponseCurve::logarithmic: return std::sqrt(value);
+            case ResponseCurve::exponential: return value * value;
+            case ResponseCurve::linear: break;
+        }
+        return value;
+    }
+
+    template <typename SampleType>
+    static inline auto boostToGain(SampleType boostdB, ResponseCurve curve) -> SampleType {
+        auto maxBoost = static_cast<SampleType>(Curves::maxBoost);
+        auto curved = Curves::applyCurve(boostdB / maxBoost, curve) * maxBoost;
+        return std::pow(SampleType(10), curved * SampleType(0.05));
+    }
+
+    template <typename SampleType>
+    static inline auto applyLFO(SampleType gain, SampleType lfoValue, SampleType amount) -> SampleType {
+        // Maps the bipolar LFO onto [1 - amount, 1]
+        return gain * (SampleType(1) - amount * (SampleType(1) - lfoValue) * SampleType(0.5));
+    }
+};
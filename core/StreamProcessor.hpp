@@ -0,0 +1,275 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "EnvelopeFollower.hpp"
+#include "Kernels.h"
+#include "ModulationMatrix.hpp"
+#include "ModulationScope.hpp"
+#include "PanningLaw.hpp"
+#include "Smoother.hpp"
+#include "StreamParameters.hpp"
+
+struct TransportEvents {
+    bool jumped = false;
+    double previousPPQ = 0.0;
+    double ppq = 0.0;
+    bool gainLFORetriggered = false;
+    bool panLFORetriggered = false;
+};
+
+// Gain, boost, pan law and modulation matrix processing for a single stereo stream
+template <typename SampleType>
+class StreamProcessor {
+public:
+    static constexpr double smoothingTime = 0.001;
+
+    // In quarter notes, hosts may round the reported position by a few samples between blocks
+    static constexpr double jumpTolerance = 0.001;
+
+    auto prepare(double newSampleRate, int maxBlockSize, KernelISA isa) -> void {
+        this->sampleRate = newSampleRate;
+        this->blockSize = std::max(1, maxBlockSize);
+        this->kernels = &Kernels::getTable<SampleType>(isa);
+        this->pcmKernels = &Kernels::getPCMTable(isa);
+
+        for (auto* buffer : {&this->gainBuffer, &this->panBuffer, &this->panLBuffer, &this->panRBuffer}) {
+            buffer->assign(static_cast<size_t>(this->blockSize), SampleType(0));
+        }
+
+        for (auto* smoother : this->getSmoothers()) {
+            smoother->reset(this->sampleRate, StreamProcessor::smoothingTime);
+        }
+
+        this->modulation.prepare(this->sampleRate, this->blockSize);
+        this->ducker.prepare(this->sampleRate, this->blockSize);
+    }
+
+    auto reset(const StreamParameters& newParameters) -> void {
+        this->parameters = newParameters;
+
+        this->gainSmoother.setCurrentAndTargetValue(static_cast<SampleType>(newParameters.gain));
+        this->boostSmoother.setCurrentAndTargetValue(static_cast<SampleType>(newParameters.boost));
+        this->panSmoother.setCurrentAndTargetValue(static_cast<SampleType>(newParameters.pan));
+        this->gainLFOAmountSmoother.setCurrentAndTargetValue(static_cast<SampleType>(newParameters.gainLFOAmount));
+        this->panLFOAmountSmoother.setCurrentAndTargetValue(static_cast<SampleType>(newParameters.panLFOAmount));
+
+        this->modulation.reset();
+        this->ducker.reset();
+    }
+
+    auto setTransport(const Transport& newTransport) -> TransportEvents {
+        TransportEvents events;
+
+        // The advance is measured over the samples actually rendered since the last call, not the prepared block size
+        double ppqAdvance = (newTransport.bpm / 60.0) / this->sampleRate * static_cast<double>(this->renderedSamples);
+        double expectedPPQ = this->transport.ppq + ppqAdvance;
+        this->renderedSamples = 0;
+
+        // A stopped host repeats its position, only a running transport can jump
+        bool running = newTransport.isPlaying && this->transport.isPlaying;
+
+        if (running && newTransport.hasPPQ && std::abs(newTransport.ppq - expectedPPQ) > StreamProcessor::jumpTolerance) {
+            events.jumped = true;
+            events.previousPPQ = this->transport.ppq;
+        }
+
+        this->transport = newTransport;
+
+        if (newTransport.hasPPQ) {
+            this->internalPPQ = newTransport.ppq;
+        } else {
+            this->internalPPQ += ppqAdvance;
+            this->transport.ppq = this->internalPPQ;
+        }
+
+        events.ppq = this->transport.ppq;
+        auto retriggered = this->modulation.syncToHost(this->transport, events.jumped);
+        events.gainLFORetriggered = (retriggered & 0b01) != 0;
+        events.panLFORetriggered = (retriggered & 0b10) != 0;
+
+        return events;
+    }
+
+    auto setParameters(const StreamParameters& newParameters) -> void {
+        this->parameters = newParameters;
+
+        this->gainSmoother.setTargetValue(static_cast<SampleType>(newParameters.gain));
+        this->boostSmoother.setTargetValue(static_cast<SampleType>(newParameters.boost));
+        this->panSmoother.setTargetValue(static_cast<SampleType>(newParameters.pan));
+        this->gainLFOAmountSmoother.setTargetValue(static_cast<SampleType>(newParameters.gainLFOAmount));
+        this->panLFOAmountSmoother.setTargetValue(static_cast<SampleType>(newParameters.panLFOAmount));
+
+        auto gainLFOFrequency = newParameters.gainLFOMode == LFOMode::synced ? 0.0f : newParameters.gainLFOFrequency;
+        this->modulation.setLFO(0, newParameters.gainLFOType, static_cast<SampleType>(newParameters.gainLFORate), 
+            static_cast<SampleType>(gainLFOFrequency));
+        this->modulation.setLFO(1, newParameters.panLFOType, static_cast<SampleType>(newParameters.panLFORate));
+
+        for (size_t aux = 0; aux < newParameters.auxLFOType.size(); aux++) {
+            this->modulation.setLFO(aux + 2, newParameters.auxLFOType[aux], static_cast<SampleType>(newParameters.auxLFORate[aux]));
+        }
+
+        this->modulation.setRoutings(newParameters.routings);
+
+        this->ducker.setParameters(static_cast<SampleType>(newParameters.duckAmount), 
+            static_cast<SampleType>(newParameters.duckAttack), static_cast<SampleType>(newParameters.duckRelease));
+    }
+
+    // Renders up to one block of per-sample gain and pan coefficients
+    auto renderBlock(int numSamples) -> void {
+        using Matrix = ModulationMatrix<SampleType>;
+        this->modulation.render(numSamples, *this->kernels);
+        this->renderedSamples += numSamples;
+
+        const auto* gainLFO = this->modulation.getOutput(0);
+        const auto* panLFO = this->modulation.getOutput(1);
+        const auto* gainModulation = this->modulation.getDestination(Matrix::gain);
+        const auto* boostModulation = this->modulation.getDestination(Matrix::boost);
+        const auto* panModulation = this->modulation.getDestination(Matrix::pan);
+        auto gainLFOScale = this->modulation.getAmountScale(0);
+        // Twice the depth maps the amount onto [1 - 2 * amount, 1], a bipolar carrier at full amount
+        if (this->parameters.gainLFOMode == LFOMode::ring) gainLFOScale *= SampleType(2);
+        auto panLFOScale = this->modulation.getAmountScale(1);
+        auto maxBoost = static_cast<SampleType>(Curves::maxBoost);
+
+        for (size_t sample = 0; sample < static_cast<size_t>(numSamples); sample++) {
+            SampleType gain = Curves::applyCurve(this->gainSmoother.getNextValue(), this->parameters.gainCurve);
+            gain = Curves::applyLFO(gain, gainLFO[sample], this->gainLFOAmountSmoother.getNextValue() * gainLFOScale);
+            gain *= std::max(SampleType(0), gainModulation[sample]);
+
+            SampleType boostdB = std::clamp(this->boostSmoother.getNextValue() + boostModulation[sample], SampleType(0), maxBoost);
+            SampleType boost = Curves::boostToGain(boostdB, this->parameters.boostCurve);
+            this->gainBuffer[sample] = gain * boost;
+
+            SampleType pan = this->panSmoother.getNextValue();
+            SampleType panLFOAmount = this->panLFOAmountSmoother.getNextValue() * panLFOScale;
+            pan += panLFO[sample] * panLFOAmount * SampleType(0.5) + panModulation[sample];
+            pan = std::clamp(pan, SampleType(-1), SampleType(1));
+            this->panBuffer[sample] = pan;
+
+            PanningLaw::apply(this->parameters.panningLaw, pan, this->panLBuffer[sample], this->panRBuffer[sample]);
+        }
+
+        if (this->ducker.process(this->sidechainL, this->sidechainR, numSamples, *this->kernels)) {
+            this->ducker.apply(this->gainBuffer.data(), numSamples, *this->kernels);
+        }
+
+        if (this->sidechainL != nullptr) {
+            this->sidechainL += numSamples;
+            this->sidechainR += numSamples;
+        }
+
+        if (this->scope != nullptr && this->scope->isEnabled()) {
+            this->scope->addBlock(this->gainBuffer.data(), this->panBuffer.data(), numSamples,
+                this->modulation.getPhase(0), this->modulation.getIncrement(0), this->modulation.getPhase(1), this->modulation.getIncrement(1));
+        }
+    }
+
+    auto process(const SampleType* inputL, const SampleType* inputR, SampleType* outputL, SampleType* outputR, int numSamples) -> void {
+        for (int offset = 0; offset < numSamples; offset += this->blockSize) {
+            int blockSamples = std::min(this->blockSize, numSamples - offset);
+            this->renderBlock(blockSamples);
+
+            this->kernels->applyGainPan(inputL + offset, inputR + offset, outputL + offset, outputR + offset,
+                this->gainBuffer.data(), this->panLBuffer.data(), this->panRBuffer.data(), blockSamples);
+        }
+
+        this->setSidechain(nullptr, nullptr);
+    }
+
+    // In place on interleaved stereo frames, same semantics as process()
+    auto processInterleaved(SampleType* frames, int numFrames) -> void {
+        for (int offset = 0; offset < numFrames; offset += this->blockSize) {
+            int blockFrames = std::min(this->blockSize, numFrames - offset);
+            this->renderBlock(blockFrames);
+
+            this->kernels->applyGainPanInterleaved(frames + 2 * offset, this->gainBuffer.data(), 
+                this->panLBuffer.data(), this->panRBuffer.data(), blockFrames);
+        }
+
+        this->setSidechain(nullptr, nullptr);
+    }
+
+    // In place on interleaved stereo PCM, integer formats are converted inside the kernel
+    auto processInterleaved(void* frames, PCMFormat format, int numFrames) -> void requires std::is_same_v<SampleType, float> {
+        if (format == PCMFormat::float32) {
+            this->processInterleaved(static_cast<float*>(frames), numFrames);
+            return;
+        }
+
+        auto* bytes = static_cast<uint8_t*>(frames);
+        int frameBytes = format == PCMFormat::int16 ? 4 : 6;
+
+        for (int offset = 0; offset < numFrames; offset += this->blockSize) {
+            int blockFrames = std::min(this->blockSize, numFrames - offset);
+            auto* block = bytes + static_cast<size_t>(offset) * static_cast<size_t>(frameBytes);
+            this->renderBlock(blockFrames);
+
+            if (format == PCMFormat::int16) {
+                this->pcmKernels->applyGainPanInt16(reinterpret_cast<int16_t*>(block), this->gainBuffer.data(),
+                    this->panLBuffer.data(), this->panRBuffer.data(), blockFrames);
+            } else {
+                this->pcmKernels->applyGainPanInt24(block, this->gainBuffer.data(),
+                    this->panLBuffer.data(), this->panRBuffer.data(), blockFrames);
+            }
+        }
+
+        this->setSidechain(nullptr, nullptr);
+    }
+
+    auto getKernels() const -> const KernelTable<SampleType>& {
+        return *this->kernels;
+    }
+
+    auto getBlockSize() const -> int {
+        return this->blockSize;
+    }
+
+    // Sidechain for the next process call only, null when the bus is disabled. Mono passes the same channel twice.
+    // It may alias the output, each chunk is read by the detector before its output is written
+    auto setSidechain(const SampleType* left, const SampleType* right) -> void {
+        this->sidechainL = left;
+        this->sidechainR = right != nullptr ? right : left;
+    }
+
+    // Rendered coefficients are summarised into the scope while it is enabled
+    auto setScope(ModulationScope* newScope) -> void {
+        this->scope = newScope;
+    }
+
+private:
+    const KernelTable<SampleType>* kernels = &Kernels::getTable<SampleType>(KernelISA::scalar);
+    const PCMKernelTable* pcmKernels = &Kernels::getPCMTable(KernelISA::scalar);
+    ModulationScope* scope = nullptr;
+    const SampleType* sidechainL = nullptr;
+    const SampleType* sidechainR = nullptr;
+    StreamParameters parameters;
+    Transport transport;
+
+    double sampleRate = 44100.0;
+    double internalPPQ = 0.0;
+    int blockSize = 512;
+    int renderedSamples = 0;
+
+    std::vector<SampleType> gainBuffer;
+    std::vector<SampleType> panBuffer;
+    std::vector<SampleType> panLBuffer;
+    std::vector<SampleType> panRBuffer;
+
+    Smoother<SampleType> gainSmoother;
+    Smoother<SampleType> boostSmoother;
+    Smoother<SampleType> panSmoother;
+    Smoother<SampleType> gainLFOAmountSmoother;
+    Smoother<SampleType> panLFOAmountSmoother;
+
+    ModulationMatrix<SampleType> modulation;
+    EnvelopeFollower<SampleType> ducker;
+
+    auto getSmoothers() -> std::array<Smoother<SampleType>*, 5> {
+        return {&this->gainSmoother, &this->boostSmoother, &this->panSmoother, 
+            &this->gainLFOAmountSmoother, &this->panLFOAmountSmoother};
+    }
+};
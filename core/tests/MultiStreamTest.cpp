@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "MultiStreamProcessor.h"
+#include "StreamProcessor.hpp"
+
+/*
+ * Runs MultiStreamProcessor against one StreamProcessor per stream, for every kernel set the CPU
+ * supports and both sample types. The stream count leaves a remainder on every SIMD width so the
+ * scalar tail is covered, and parameters change partway through so the ramps are compared too.
+ */
+
+static constexpr int numStreams = 11;
+static constexpr int blockSize = 480;
+static constexpr int numBlocks = 200;
+static constexpr double sampleRate = 48000.0;
+
+static auto makeParameters(int stream, bool changed) -> StreamParameters {
+    static constexpr ResponseCurve curves[] = {ResponseCurve::logarithmic, ResponseCurve::linear, ResponseCurve::exponential};
+    static constexpr PanLaw laws[] = {PanLaw::constant, PanLaw::triangle, PanLaw::linear};
+    static constexpr LFOShape shapes[] = {LFOShape::square, LFOShape::saw, LFOShape::triangle, LFOShape::sine};
+    static constexpr float rates[] = {0.0625f, 0.125f, 0.25f, 0.5f, 1.0f};
+
+    auto index = static_cast<size_t>(stream);
+    StreamParameters parameters;
+
+    parameters.gain = changed ? 0.4f + 0.05f * static_cast<float>(stream) : 1.0f - 0.05f * static_cast<float>(stream);
+    parameters.gainCurve = curves[index % 3];
+    parameters.boost = changed ? 12.0f - static_cast<float>(stream) : static_cast<float>(stream);
+    parameters.boostCurve = curves[(index + 1) % 3];
+    parameters.pan = (changed ? -0.7f : 0.6f) + 0.1f * static_cast<float>(stream % 5);
+    parameters.panningLaw = laws[index % 3];
+
+    parameters.gainLFOType = shapes[index % 4];
+    parameters.gainLFORate = rates[index % 5];
+    parameters.gainLFOAmount = changed ? 0.3f : 0.8f;
+    parameters.panLFOType = shapes[(index + 2) % 4];
+    parameters.panLFORate = rates[(index + 3) % 5];
+    parameters.panLFOAmount = changed ? 0.9f : 0.5f;
+
+    return parameters;
+}
+
+// Largest absolute difference between the two processors over every stream and sample
+template <typename SampleType>
+static auto compare(KernelISA isa, KernelISA referenceISA) -> double {
+    // An odd tempo keeps LFO edges from landing exactly on a sample, where rounding could pick either side
+    Transport transport;
+    transport.bpm = 133.7;
+
+    MultiStreamProcessor<SampleType> multi;
+    multi.prepare(numStreams, sampleRate, isa);
+    multi.setTransport(transport);
+
+    std::vector<StreamProcessor<SampleType>> streams(static_cast<size_t>(numStreams));
+
+    for (int stream = 0; stream < numStreams; stream++) {
+        auto& processor = streams[static_cast<size_t>(stream)];
+        processor.prepare(sampleRate, blockSize, referenceISA);
+        processor.setTransport(transport);
+        processor.reset(makeParameters(stream, false));
+        multi.resetStream(stream, makeParameters(stream, false));
+    }
+
+    auto frameSize = static_cast<size_t>(blockSize) * static_cast<size_t>(numStreams);
+    std::vector<SampleType> inputL(frameSize), inputR(frameSize), outputL(frameSize), outputR(frameSize);
+    std::vector<SampleType> streamL(blockSize), streamR(blockSize), expectedL(blockSize), expectedR(blockSize);
+    double maxError = 0.0;
+
+    for (int block = 0; block < numBlocks; block++) {
+        bool changed = block >= numBlocks / 2;
+
+        for (size_t index = 0; index < frameSize; index++) {
+            auto position = static_cast<double>(static_cast<size_t>(block) * frameSize + index);
+            inputL[index] = static_cast<SampleType>(std::sin(position * 0.0137));
+            inputR[index] = static_cast<SampleType>(std::cos(position * 0.0071));
+        }
+
+        multi.setTransport(transport);
+        for (int stream = 0; stream < numStreams; stream++) multi.setParameters(stream, makeParameters(stream, changed));
+        multi.process(inputL.data(), inputR.data(), outputL.data(), outputR.data(), blockSize);
+
+        for (int stream = 0; stream < numStreams; stream++) {
+            auto& processor = streams[static_cast<size_t>(stream)];
+
+            for (size_t sample = 0; sample < static_cast<size_t>(blockSize); sample++) {
+                auto index = sample * static_cast<size_t>(numStreams) + static_cast<size_t>(stream);
+                streamL[sample] = inputL[index];
+                streamR[sample] = inputR[index];
+            }
+
+            processor.setTransport(transport);
+            processor.setParameters(makeParameters(stream, changed));
+            processor.process(streamL.data(), streamR.data(), expectedL.data(), expectedR.data(), blockSize);
+
+            for (size_t sample = 0; sample < static_cast<size_t>(blockSize); sample++) {
+                auto index = sample * static_cast<size_t>(numStreams) + static_cast<size_t>(stream);
+                maxError = std::max(maxError, static_cast<double>(std::abs(outputL[index] - expectedL[sample])));
+                maxError = std::max(maxError, static_cast<double>(std::abs(outputR[index] - expectedR[sample])));
+            }
+        }
+    }
+
+    return maxError;
+}
+
+auto main() -> int {
+    // The polynomial sine is within 4e-6, so both sample types stay inside this
+    static constexpr double tolerance = 1.0e-5;
+    int failures = 0;
+
+    for (auto isa : {KernelISA::scalar, KernelISA::sse2, KernelISA::avx2, KernelISA::avx512, KernelISA::neon}) {
+        if (!Kernels::isSupported(isa)) continue;
+
+        // The SIMD StreamProcessor kernels step LFO phase a register at a time, in float that lands
+        // edges a sample away from per-sample accumulation, so float is held to the scalar reference
+        double floatError = compare<float>(isa, KernelISA::scalar);
+        double doubleError = compare<double>(isa, isa);
+        bool passed = floatError <= tolerance && doubleError <= tolerance;
+        if (!passed) failures++;
+
+        std::printf("%-7s float %.3g double %.3g %s\n", Kernels::getISAName(isa), floatError, doubleError, passed ? "ok" : "FAILED");
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -1,16 +0,0 @@
-/* (Auto-generated binary data file). */
-
-#pragma once
-
-namespace BinaryData
-{
-    extern const char*  parameters_json;
-    const int           parameters_jsonSize = 626;
-
-    extern const char*  presets_zip;
-    const int           presets_zipSize = 6479;
-
-    extern const char*  webview_files_zip;
-    const int           webview_files_zipSize = 3002900;
-
-}
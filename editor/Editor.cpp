@@ -3,11 +3,20 @@
 #include "Functions.hpp"
 #include "Settings.hpp"
 #include "BinaryData.h"
+#include "Trace.hpp"
 
 Editor::Editor(Processor& p) : AudioProcessorEditor(&p), processor(p),
-    webview(webviewOptions()) {
-
-    webview.goToURL(webview.getResourceProviderRoot());
+    parameterSync(p.tree, [this](const var& batch) {
+        this->webview->emitEventIfBrowserIsVisible("parameterSync", batch);
+    }),
+    modulationStream(p.parameters.modulationScope, [this](const var& payload) {
+        this->webview->emitEventIfBrowserIsVisible("modulationScope", payload);
+    }) {
+
+    // Leased once every member exists, the native functions capture this and the pool may call them
+    // as soon as the lease is handed over. The senders above only run from timers, after this
+    this->webviewLease = p.webviewPool->lease(Editor::getResource, this->nativeFunctions());
+    this->webview = &this->webviewLease->getWebview();
 
     int width = static_cast<int>(Settings::getSettingKey("windowWidth", 510));
     int height = static_cast<int>(Settings::getSettingKey("windowHeight", 580));
@@ -24,54 +33,66 @@ Editor::Editor(Processor& p) : AudioProcessorEditor(&p), processor(p),
     this->setResizable(true, true);
     this->setSize(width, height);
 
-    this->addAndMakeVisible(webview);
+    this->addAndMakeVisible(*this->webview);
 
     EventEmitter::instance().addListener(this);
 }
 
 Editor::~Editor() {
     EventEmitter::instance().removeListener(this);
+    this->removeChildComponent(this->webview);
+}
+
+auto Editor::nativeFunctions() -> WebviewPool::NativeFunctions {
+    return {
+        {"getParameterMetadata", [this]([[maybe_unused]] auto args, auto completion){ 
+            auto obj = std::make_unique<DynamicObject>();
+            obj->setProperty("generation", this->webviewLease->getGeneration());
+            obj->setProperty("parameters", this->parameterSync.getMetadata());
+            return completion(var{obj.release()});
+        }},
+        {"syncParameters", [this](auto args, auto completion){ 
+            // Batches the page queued for the webview's previous editor carry an older generation,
+            // the reply lets a page that missed editorAttached notice and refetch
+            int generation = this->webviewLease->getGeneration();
+            if (static_cast<int>(args[1]) == generation) {
+                if (auto* batch = args[0].getArray()) this->parameterSync.applyBatch(*batch);
+            }
+            return completion(generation);
+        }},
+        {"openPresetMenu", [this](auto args, auto completion){ 
+            return this->processor.presetManager.openPresetMenu(args, completion); 
+        }},
+        {"prevPreset", [this](auto args, auto completion){ 
+            return this->processor.presetManager.prevPreset(args, completion); 
+        }},
+        {"nextPreset", [this](auto args, auto completion){ 
+            return this->processor.presetManager.nextPreset(args, completion); 
+        }},
+        {"searchPresets", [this](auto args, auto completion){ 
+            return this->processor.presetManager.searchPresets(args, completion); 
+        }},
+        {"selectPreset", [this](auto args, auto completion){ 
+            return this->processor.presetManager.selectPreset(args, completion); 
+        }},
+        {"currentPresetName", [this]([[maybe_unused]] auto args, auto completion){ 
+            return completion(this->processor.presetManager.currentPresetName);
+        }},
+        {"getPerformanceStats", [this](auto args, auto completion){ 
+            return this->processor.getPerformanceStats(args, completion); 
+        }}
+    };
 }
 
-auto Editor::webviewOptions() -> WebBrowserComponent::Options {
-    return WebBrowserComponent::Options{}
-    .withBackend(WebBrowserComponent::Options::Backend::webview2)
-    .withWinWebView2Options(WebBrowserComponent::Options::WinWebView2{}
-    .withUserDataFolder(File::getSpecialLocation(File::tempDirectory)))
-    .withResourceProvider([this](const auto& url) { return getResource(url); })
-    .withNativeIntegrationEnabled()
-    .withKeepPageLoadedWhenBrowserIsHidden()
-    .withOptionsFrom(gainRelay)
-    .withOptionsFrom(boostRelay)
-    .withOptionsFrom(panRelay)
-    .withOptionsFrom(gainCurveRelay)
-    .withOptionsFrom(boostCurveRelay)
-    .withOptionsFrom(panningLawRelay)
-    .withOptionsFrom(gainLFOTypeRelay)
-    .withOptionsFrom(gainLFORateRelay)
-    .withOptionsFrom(gainLFOAmountRelay)
-    .withOptionsFrom(panLFOTypeRelay)
-    .withOptionsFrom(panLFORateRelay)
-    .withOptionsFrom(panLFOAmountRelay)
-    .withNativeFunction("getDefaultParameter", [this](auto args, auto completion){ 
-        return this->processor.parameters.getDefaultParameter(args, completion); 
-    })
-    .withNativeFunction("openPresetMenu", [this](auto args, auto completion){ 
-        return this->processor.presetManager.openPresetMenu(args, completion); 
-    })
-    .withNativeFunction("prevPreset", [this](auto args, auto completion){ 
-        return this->processor.presetManager.prevPreset(args, completion); 
-    })
-    .withNativeFunction("nextPreset", [this](auto args, auto completion){ 
-        return this->processor.presetManager.nextPreset(args, completion); 
-    })
-    .withNativeFunction("currentPresetName", [this]([[maybe_unused]] auto args, auto completion){ 
-        return completion(this->processor.presetManager.currentPresetName);
-    });
+auto Editor::parentHierarchyChanged() -> void {
+    // A reused page still shows the previous editor's processor, it can only be told once on screen
+    if (this->attachAnnounced || !this->isShowing()) return;
+    this->attachAnnounced = true;
+    this->webview->emitEventIfBrowserIsVisible("editorAttached", this->webviewLease->getGeneration());
 }
 
 auto Editor::resized() -> void {
-    webview.setBounds(getLocalBounds());
+    this->webview->setBounds(getLocalBounds());
     Settings::setSettingKey("windowWidth", getWidth());
     Settings::setSettingKey("windowHeight", getHeight());
 }
@@ -92,6 +113,7 @@ auto Editor::getWebviewFileBytes(const String& resourceStr) -> std::vector<std::
 }
 
 auto Editor::getResource(const String& url) -> std::optional<WebBrowserComponent::Resource> {
+    TRACE_SCOPE("Editor::getResource");
     static auto fileRoot = File::getCurrentWorkingDirectory().getChildFile("dist");
     auto resourceStr = url == "/" ? "index.html" : url.fromFirstOccurrenceOf("/", false, false);
     auto ext = resourceStr.fromLastOccurrenceOf(".", false, false);
@@ -113,6 +135,6 @@ auto Editor::getResource(const String& url) -> std::optional<WebBrowserComponent
 
 auto Editor::handleEvent(const String& name, const var& payload) -> void {
     if (name == "presetChanged") {
-        this->webview.emitEventIfBrowserIsVisible(Identifier{name}, payload.toString());
+        this->webview->emitEventIfBrowserIsVisible(Identifier{name}, payload.toString());
     }
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <map>
+
+/*
+ * Runs preset file work (reads, writes, folder scans, parsing) off the message thread. All
+ * instances share one I/O thread, started on the first job, so jobs run in submission order.
+ *
+ * A job returns a completion that is posted back to the message thread. Submitting under a key
+ * cancels the previous job with that key, and a cancelled or destroyed worker drops completions,
+ * so jobs must only touch the data they captured, never the owner.
+ */
+class IOWorker {
+public:
+    class Token {
+    public:
+        auto isCancelled() const -> bool {
+            return this->cancelled.load(std::memory_order_acquire);
+        }
+
+    private:
+        friend class IOWorker;
+        std::atomic<bool> cancelled{false};
+    };
+
+    using Completion = std::function<void()>;
+    using Work = std::function<Completion(const Token& token)>;
+
+    IOWorker() = default;
+
+    ~IOWorker() {
+        this->cancelAll();
+    }
+
+    auto submit(const String& key, Work work) -> void {
+        JUCE_ASSERT_MESSAGE_THREAD
+        this->cancel(key);
+
+        auto token = std::make_shared<Token>();
+        this->tokens[key] = token;
+
+        if (this->pool == nullptr) this->pool = std::make_unique<SharedResourcePointer<SharedPool>>();
+
+        (*this->pool)->addJob([token, work = std::move(work)] {
+            if (token->isCancelled()) return;
+
+            auto completion = work(*token);
+            if (!completion || token->isCancelled()) return;
+
+            MessageManager::callAsync([token, completion = std::move(completion)] {
+                if (!token->isCancelled()) completion();
+            });
+        });
+    }
+
+    auto cancel(const String& key) -> void {
+        auto it = this->tokens.find(key);
+        if (it == this->tokens.end()) return;
+
+        it->second->cancelled.store(true, std::memory_order_release);
+        this->tokens.erase(it);
+    }
+
+    auto cancelAll() -> void {
+        for (auto& [key, token] : this->tokens) token->cancelled.store(true, std::memory_order_release);
+        this->tokens.clear();
+    }
+
+private:
+    struct SharedPool : public ThreadPool {
+        SharedPool() : ThreadPool(ThreadPoolOptions{}.withThreadName("Preset I/O").withNumberOfThreads(1)) {}
+    };
+
+    std::unique_ptr<SharedResourcePointer<SharedPool>> pool;
+    std::map<String, std::shared_ptr<Token>> tokens;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(IOWorker)
+};
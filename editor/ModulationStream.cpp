@@ -0,0 +1,48 @@
+#include "ModulationStream.h"
+#include "Trace.hpp"
+
+ModulationStream::ModulationStream(ModulationScope& scope, Sender sender) : scope(scope), sender(std::move(sender)) {
+    this->columns.resize(static_cast<size_t>(ModulationScope::capacity));
+
+    // Columns left over from a previous editor would replay stale modulation
+    this->scope.discard();
+    this->scope.setEnabled(true);
+    this->startTimerHz(ModulationStream::frameRate);
+}
+
+ModulationStream::~ModulationStream() {
+    this->stopTimer();
+    this->scope.setEnabled(false);
+}
+
+auto ModulationStream::timerCallback() -> void {
+    int numColumns = this->scope.read(this->columns.data(), static_cast<int>(this->columns.size()));
+    if (numColumns == 0 || !this->sender) return;
+
+    TRACE_SCOPE("ModulationStream::send");
+    constexpr int valuesPerColumn = 6;
+    this->packed.setSize(static_cast<size_t>(2 + numColumns * valuesPerColumn) * sizeof(uint16), false);
+    auto* data = static_cast<uint16*>(this->packed.getData());
+
+    auto quantise = [](float value, float start, float end) -> uint16 {
+        auto normalised = jlimit(0.0f, 1.0f, (value - start) / (end - start));
+        return ByteOrder::swapIfBigEndian(static_cast<uint16>(std::lround(normalised * 65535.0f)));
+    };
+
+    data[0] = ByteOrder::swapIfBigEndian(static_cast<uint16>(numColumns));
+    data[1] = ByteOrder::swapIfBigEndian(static_cast<uint16>(std::lround(this->scope.getColumnRate())));
+
+    for (int i = 0; i < numColumns; i++) {
+        const auto& column = this->columns[static_cast<size_t>(i)];
+        auto* dest = data + 2 + i * valuesPerColumn;
+
+        dest[0] = quantise(column.gainMin, 0.0f, ModulationStream::gainScale);
+        dest[1] = quantise(column.gainMax, 0.0f, ModulationStream::gainScale);
+        dest[2] = quantise(column.panMin, -1.0f, 1.0f);
+        dest[3] = quantise(column.panMax, -1.0f, 1.0f);
+        dest[4] = quantise(column.gainLFOPhase, 0.0f, 1.0f);
+        dest[5] = quantise(column.panLFOPhase, 0.0f, 1.0f);
+    }
+
+    this->sender(Base64::toBase64(this->packed.getData(), this->packed.getSize()));
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <JuceHeader.h>
+#include "ModulationScope.hpp"
+
+/*
+ * Forwards the processor's ModulationScope to the webview at a capped rate. Each timer tick drains
+ * the new columns and sends them as one modulationScope event, a base64 string of little-endian
+ * uint16 values: a [numColumns, columnRate] header followed by six quantised values per column
+ * (gain min/max, pan min/max, gain and pan LFO phase). The scope is only enabled while this exists.
+ */
+class ModulationStream : private Timer {
+public:
+    static constexpr int frameRate = 30;
+    static constexpr float gainScale = 4.0f;
+
+    using Sender = std::function<void(const var& payload)>;
+
+    ModulationStream(ModulationScope& scope, Sender sender);
+    ~ModulationStream() override;
+
+private:
+    ModulationScope& scope;
+    Sender sender;
+    std::vector<ScopeColumn> columns;
+    MemoryBlock packed;
+
+    auto timerCallback() -> void override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulationStream)
+};
@@ -2,10 +2,21 @@
 #import "NativeMenuBridge.h"
 
 static std::function<void(int)> endCallback = nullptr;
+static NativeMenuProvider menuProvider = nullptr;
 
-@interface MenuDelegate : NSObject 
+@interface LazyMenu : NSMenu
+@property (nonatomic) int handle;
+@property (nonatomic) BOOL populated;
 @end
 
+@implementation LazyMenu
+@end
+
+@interface MenuDelegate : NSObject <NSMenuDelegate>
+@end
+
+static void populateMenu(NSMenu* menu, int handle, MenuDelegate* delegate);
+
 @implementation MenuDelegate
 - (void) menuItemSelected: (id) sender {
     NSMenuItem* item = (NSMenuItem*) sender;
@@ -15,84 +26,63 @@ static std::function<void(int)> endCallback = nullptr;
     }
     endCallback = nullptr;
 }
-@end
 
-void showNativeMacMenu(const std::map<int, std::string>& items, 
-    const std::map<int, std::string>& factoryItems,
-    const std::map<int, std::string>& userItems, const std::string& userFolder,
-    const std::string& currentPresetName, const std::string& presetFolder,
-    std::function<void(int)> callback) {
-    endCallback = callback;
+- (void) menuNeedsUpdate: (NSMenu*) menu {
+    LazyMenu* lazyMenu = (LazyMenu*) menu;
+    if (lazyMenu.populated) return;
 
-    NSMenu* menu = [[NSMenu alloc] initWithTitle: @"Preset Menu"];
-    MenuDelegate* delegate = [[MenuDelegate alloc] init];
+    lazyMenu.populated = YES;
+    populateMenu(lazyMenu, lazyMenu.handle, self);
+}
+@end
 
-    for (const auto& pair : items) {
-        NSString* title = [NSString stringWithUTF8String:pair.second.c_str()];
+static void populateMenu(NSMenu* menu, int handle, MenuDelegate* delegate) {
+    if (!menuProvider) return;
 
-        NSMenuItem* menuItem = [[NSMenuItem alloc] initWithTitle: title
-                action: @selector(menuItemSelected:) keyEquivalent: @""];
+    for (const auto& item : menuProvider(handle)) {
+        NSString* title = [NSString stringWithUTF8String: item.label.c_str()];
 
-        menuItem.target = delegate;
-        menuItem.tag = pair.first;
-        [menu addItem: menuItem];
-    }
+        if (item.submenu >= 0) {
+            LazyMenu* submenu = [[LazyMenu alloc] initWithTitle: title];
+            submenu.handle = item.submenu;
+            submenu.delegate = delegate;
 
-    if (!factoryItems.empty()) {
-        NSMenu* factoryMenu = [[NSMenu alloc] initWithTitle:@"Factory"];
+            NSMenuItem* submenuItem = [[NSMenuItem alloc] initWithTitle: title
+                action: nil keyEquivalent: @""];
 
-        for (const auto& pair : factoryItems) {
-            NSString* title = [NSString stringWithUTF8String:pair.second.c_str()];
-            NSMenuItem* factoryMenuItem = [[NSMenuItem alloc] initWithTitle:title
-                action: @selector(menuItemSelected:) keyEquivalent: @""];
+            [submenuItem setSubmenu: submenu];
+            [menu addItem: submenuItem];
+            continue;
+        }
 
-            factoryMenuItem.target = delegate;
-            factoryMenuItem.tag = pair.first;
-            if (presetFolder == "factory" && pair.second == currentPresetName) {
-                [factoryMenuItem setState:NSControlStateValueOn];
-            }
+        NSMenuItem* menuItem = [[NSMenuItem alloc] initWithTitle: title
+            action: @selector(menuItemSelected:) keyEquivalent: @""];
 
-            [factoryMenu addItem:factoryMenuItem];
+        menuItem.target = delegate;
+        menuItem.tag = item.id;
+        if (item.checked) {
+            [menuItem setState: NSControlStateValueOn];
         }
 
-        NSMenuItem* factoryMenuItem = [[NSMenuItem alloc] initWithTitle: @"Factory"
-               action:nil keyEquivalent: @""];
-
-        [factoryMenuItem setSubmenu: factoryMenu];
-        [menu addItem: factoryMenuItem];
+        [menu addItem: menuItem];
     }
+}
 
-    if (!userItems.empty()) {
-        NSString* nsUserFolder = [NSString stringWithUTF8String: userFolder.c_str()];
-        NSMenu* userMenu = [[NSMenu alloc] initWithTitle: nsUserFolder];
-
-        for (const auto& pair : userItems) {
-            NSString* title = [NSString stringWithUTF8String:pair.second.c_str()];
-            NSMenuItem* userMenuItem = [[NSMenuItem alloc] initWithTitle:title
-                action: @selector(menuItemSelected:) keyEquivalent: @""];
-
-            userMenuItem.target = delegate;
-            userMenuItem.tag = pair.first;
-            if (presetFolder == "user" && pair.second == currentPresetName) {
-                [userMenuItem setState:NSControlStateValueOn];
-            }
-
-            [userMenu addItem: userMenuItem];
-        }
-
-        NSMenuItem* userMenuItem = [[NSMenuItem alloc] initWithTitle: nsUserFolder
-               action:nil keyEquivalent: @""];
+void showNativeMacMenu(NativeMenuProvider provider, std::function<void(int)> callback) {
+    endCallback = callback;
+    menuProvider = provider;
 
-        [userMenuItem setSubmenu: userMenu];
-        [menu addItem: userMenuItem];
-    }
+    NSMenu* menu = [[NSMenu alloc] initWithTitle: @"Preset Menu"];
+    MenuDelegate* delegate = [[MenuDelegate alloc] init];
+    populateMenu(menu, 0, delegate);
 
     NSPoint mouseLocation = [NSEvent mouseLocation];
-    CGFloat estimatedMenuHeight = (items.size() + 2) * 22.0;
+    CGFloat estimatedMenuHeight = menu.numberOfItems * 22.0;
     CGFloat estimatedMenuWidth = 110.0;
 
     mouseLocation.y += estimatedMenuHeight;
     mouseLocation.x -= estimatedMenuWidth / 2.0;
 
     [menu popUpMenuPositioningItem: nil atLocation:mouseLocation inView: nil];
+    menuProvider = nullptr;
 }
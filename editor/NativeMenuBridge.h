@@ -1,21 +1,24 @@
 #pragma once
 #include <functional>
-#include <map>
+#include <string>
+#include <vector>
+
+struct NativeMenuItem {
+    int id = 0;
+    std::string label;
+    bool checked = false;
+    // Handle passed back to the provider when this submenu opens, -1 for a plain item
+    int submenu = -1;
+};
+
+// Returns the items of one menu level, the root level has handle 0. Submenus are only
+// requested when they are about to open, so large libraries never build the whole tree.
+using NativeMenuProvider = std::function<std::vector<NativeMenuItem>(int handle)>;
 
 #ifdef __APPLE__
-void showNativeMacMenu(const std::map<int, std::string>& items, 
-    const std::map<int, std::string>& factoryItems,
-    const std::map<int, std::string>& userItems, const std::string& userFolder,
-    const std::string& currentPresetName,
-    const std::string& presetFolder,
-    std::function<void(int)> callback);
+void showNativeMacMenu(NativeMenuProvider provider, std::function<void(int)> callback);
 #endif
 
 #ifdef _WIN32
-void showNativeWinMenu(const std::map<int, std::string>& items,
-    const std::map<int, std::string>& factoryItems,
-    const std::map<int, std::string>& userItems, const std::string& userFolder,
-    const std::string& currentPresetName,
-    const std::string& presetFolder,
-    std::function<void(int)> callback);
-#endif
\ No newline at end of file
+void showNativeWinMenu(NativeMenuProvider provider, std::function<void(int)> callback);
+#endif
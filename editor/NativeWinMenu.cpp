@@ -2,15 +2,18 @@
 #include <windows.h>
 #include <uxtheme.h>
 #include <dwmapi.h>
+#include <commctrl.h>
 #include <map>
 #include <string>
 #include <functional>
 #include <Shlwapi.h>
 #include <winreg.h>
+#include "NativeMenuBridge.h"
 
 #pragma comment(lib, "uxtheme.lib")
 #pragma comment(lib, "dwmapi.lib")
 #pragma comment(lib, "Shlwapi.lib")
+#pragma comment(lib, "comctl32.lib")
 
 typedef enum _PreferredAppMode {
     Default,
@@ -49,43 +52,52 @@ bool isSystemInDarkMode() {
     return false;
 }
 
-void showNativeWinMenu(const std::map<int, std::string>& items,
-    const std::map<int, std::string>& factoryItems,
-    const std::map<int, std::string>& userItems, const std::string& userFolder,
-    const std::string& currentPresetName,
-    const std::string& presetFolder,
-    std::function<void(int)> callback) {
-    
-    HMENU hMenu = CreatePopupMenu();
-
-    for (const auto& [id, label] : items) {
-        AppendMenuA(hMenu, MF_STRING, id, label.c_str());
-    }
-
-    if (!factoryItems.empty()) {
-        HMENU factorySub = CreatePopupMenu();
-        for (const auto& [id, name] : factoryItems) {
-            UINT flags = MF_STRING;
-            if (presetFolder == "factory" && name == currentPresetName) {
-                flags |= MF_CHECKED;
+struct LazyMenuState {
+    NativeMenuProvider provider;
+    std::map<HMENU, int> pending;
+    bool eager = false;
+};
+
+static void populateMenu(HMENU menu, int handle, LazyMenuState& state) {
+    for (const auto& item : state.provider(handle)) {
+        if (item.submenu >= 0) {
+            HMENU submenu = CreatePopupMenu();
+            AppendMenuA(menu, MF_POPUP, (UINT_PTR)submenu, item.label.c_str());
+
+            if (state.eager) {
+                populateMenu(submenu, item.submenu, state);
+            } else {
+                state.pending[submenu] = item.submenu;
             }
-            AppendMenuA(factorySub, flags, id, name.c_str());
+            continue;
         }
-        AppendMenuA(hMenu, MF_POPUP, (UINT_PTR)factorySub, "Factory");
+
+        UINT flags = MF_STRING;
+        if (item.checked) {
+            flags |= MF_CHECKED;
+        }
+        AppendMenuA(menu, flags, item.id, item.label.c_str());
     }
+}
 
-    if (!userItems.empty()) {
-        HMENU userSub = CreatePopupMenu();
-        for (const auto& [id, name] : userItems) {
-            UINT flags = MF_STRING;
-            if (presetFolder == "user" && name == currentPresetName) {
-                flags |= MF_CHECKED;
-            }
-            AppendMenuA(userSub, flags, id, name.c_str());
+// Fills each submenu from the provider the first time it is about to be shown
+static LRESULT CALLBACK lazyMenuProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam,
+    [[maybe_unused]] UINT_PTR subclassID, DWORD_PTR refData) {
+    if (message == WM_INITMENUPOPUP) {
+        auto& state = *reinterpret_cast<LazyMenuState*>(refData);
+        auto menu = reinterpret_cast<HMENU>(wParam);
+        auto it = state.pending.find(menu);
+
+        if (it != state.pending.end()) {
+            int handle = it->second;
+            state.pending.erase(it);
+            populateMenu(menu, handle, state);
         }
-        AppendMenuA(hMenu, MF_POPUP, (UINT_PTR)userSub, userFolder.c_str());
     }
+    return DefSubclassProc(hwnd, message, wParam, lParam);
+}
 
+void showNativeWinMenu(NativeMenuProvider provider, std::function<void(int)> callback) {
     POINT pt;
     GetCursorPos(&pt);
 
@@ -95,11 +107,24 @@ void showNativeWinMenu(const std::map<int, std::string>& items,
         enableDarkMode(hwnd);
     }
 
+    // Subclassing only works on windows of this thread, otherwise the menu is built up front
+    LazyMenuState state{provider};
+    DWORD windowThread = GetWindowThreadProcessId(hwnd, nullptr);
+    state.eager = windowThread != GetCurrentThreadId()
+        || !SetWindowSubclass(hwnd, lazyMenuProc, 1, reinterpret_cast<DWORD_PTR>(&state));
+
+    HMENU hMenu = CreatePopupMenu();
+    populateMenu(hMenu, 0, state);
+
     int cmd = TrackPopupMenu(hMenu,
         TPM_RETURNCMD | TPM_TOPALIGN | TPM_LEFTALIGN,
         pt.x, pt.y, 0, hwnd, NULL
     );
 
+    if (!state.eager) {
+        RemoveWindowSubclass(hwnd, lazyMenuProc, 1);
+    }
+
     if (cmd != 0 && callback) {
         callback(cmd);
     }
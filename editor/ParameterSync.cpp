@@ -0,0 +1,128 @@
+#include "ParameterSync.h"
+#include "ParameterIDs.hpp"
+#include "Trace.hpp"
+
+ParameterSync::ParameterSync(AudioProcessorValueTreeState& tree, Sender sender) : sender(std::move(sender)) {
+    for (const auto& id : ParameterIDs::getStringKeys()) {
+        auto* param = tree.getParameter(id);
+        if (param == nullptr) continue;
+
+        jassert(static_cast<int>(this->parameters.size()) < ParameterSync::maxParameters);
+        if (static_cast<int>(this->parameters.size()) == ParameterSync::maxParameters) break;
+
+        auto index = static_cast<size_t>(param->getParameterIndex());
+        if (this->slotForIndex.size() <= index) this->slotForIndex.resize(index + 1, -1);
+
+        this->slotForIndex[index] = static_cast<int>(this->parameters.size());
+        this->parameters.push_back(param);
+        param->addListener(this);
+    }
+
+    this->openGestures.assign(this->parameters.size(), false);
+    this->startTimerHz(ParameterSync::frameRate);
+}
+
+ParameterSync::~ParameterSync() {
+    this->stopTimer();
+
+    for (size_t slot = 0; slot < this->parameters.size(); slot++) {
+        // A webview torn down mid drag never sends its end, so the host gesture is closed here
+        if (this->openGestures[slot]) this->parameters[slot]->endChangeGesture();
+        this->parameters[slot]->removeListener(this);
+    }
+}
+
+auto ParameterSync::getNumSlots() const -> int {
+    return static_cast<int>(this->parameters.size());
+}
+
+auto ParameterSync::getParameter(int slot) const -> RangedAudioParameter* {
+    return this->parameters[static_cast<size_t>(slot)];
+}
+
+auto ParameterSync::getMetadata() const -> var {
+    TRACE_SCOPE("ParameterSync::getMetadata");
+    Array<var> slots;
+    slots.ensureStorageAllocated(static_cast<int>(this->parameters.size()));
+
+    for (auto* param : this->parameters) {
+        auto obj = std::make_unique<DynamicObject>();
+        const auto& range = param->getNormalisableRange();
+
+        obj->setProperty("id", param->getParameterID());
+        obj->setProperty("name", param->getName(100));
+        obj->setProperty("label", param->getLabel());
+        obj->setProperty("start", range.start);
+        obj->setProperty("end", range.end);
+        obj->setProperty("interval", range.interval);
+        obj->setProperty("skew", range.skew);
+        obj->setProperty("numSteps", param->getNumSteps());
+        obj->setProperty("choices", var{param->getAllValueStrings()});
+        obj->setProperty("defaultValue", param->convertFrom0to1(param->getDefaultValue()));
+        obj->setProperty("value", param->convertFrom0to1(param->getValue()));
+        slots.add(var{obj.release()});
+    }
+
+    return slots;
+}
+
+auto ParameterSync::applyBatch(const Array<var>& operations) -> void {
+    TRACE_SCOPE("ParameterSync::applyBatch");
+    auto numSlots = static_cast<int>(this->parameters.size());
+
+    for (int i = 0; i + 2 < operations.size(); i += 3) {
+        int operation = static_cast<int>(operations[i]);
+        int slot = static_cast<int>(operations[i + 1]);
+        if (slot < 0 || slot >= numSlots) continue;
+
+        auto* param = this->parameters[static_cast<size_t>(slot)];
+        auto index = static_cast<size_t>(slot);
+
+        if (operation == ParameterSync::beginGesture && !this->openGestures[index]) {
+            this->openGestures[index] = true;
+            param->beginChangeGesture();
+        } else if (operation == ParameterSync::endGesture && this->openGestures[index]) {
+            this->openGestures[index] = false;
+            param->endChangeGesture();
+        } else if (operation == ParameterSync::setValue) {
+            auto value = static_cast<float>(static_cast<double>(operations[i + 2]));
+
+            // The listener runs synchronously in here, this keeps the change from echoing back
+            this->applyingSlot = slot;
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+            this->applyingSlot = -1;
+        }
+    }
+}
+
+auto ParameterSync::parameterValueChanged(int parameterIndex, [[maybe_unused]] float newValue) -> void {
+    auto index = static_cast<size_t>(parameterIndex);
+    if (index >= this->slotForIndex.size() || this->slotForIndex[index] < 0) return;
+
+    int slot = this->slotForIndex[index];
+    if (slot == this->applyingSlot && MessageManager::existsAndIsCurrentThread()) return;
+
+    // May run on the audio thread during automation, so only a bit is set and the value is read at send time
+    this->dirtySlots.fetch_or(uint64{1} << slot, std::memory_order_release);
+}
+
+auto ParameterSync::parameterGestureChanged([[maybe_unused]] int parameterIndex, [[maybe_unused]] bool gestureIsStarting) -> void {}
+
+auto ParameterSync::timerCallback() -> void {
+    auto dirty = this->dirtySlots.exchange(0, std::memory_order_acquire);
+    if (dirty == 0 || !this->sender) return;
+
+    TRACE_SCOPE("ParameterSync::send");
+    Array<var> batch;
+    batch.ensureStorageAllocated(2 * static_cast<int>(this->parameters.size()));
+
+    for (size_t slot = 0; slot < this->parameters.size(); slot++) {
+        if ((dirty & (uint64{1} << slot)) == 0) continue;
+
+        auto* param = this->parameters[slot];
+        batch.add(static_cast<int>(slot));
+        batch.add(param->convertFrom0to1(param->getValue()));
+    }
+
+    this->sender(batch);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ * One channel for all parameter traffic between the webview and the processor, replacing a relay
+ * and attachment per parameter. Host-side changes from any thread only mark a slot dirty, and the
+ * message thread sends every dirty slot in one parameterSync event per frame as a flat
+ * [slot, value, slot, value, ...] array of plain (denormalised) values.
+ *
+ * The webview sends its own frame batches to syncParameters as flat [operation, slot, value]
+ * triples, so a drag's begin, coalesced value and end gesture keep their order.
+ */
+class ParameterSync : private AudioProcessorParameter::Listener, private Timer {
+public:
+    enum Operation {
+        setValue = 0,
+        beginGesture = 1,
+        endGesture = 2
+    };
+
+    static constexpr int frameRate = 60;
+    static constexpr int maxParameters = 64;
+
+    using Sender = std::function<void(const var& batch)>;
+
+    ParameterSync(AudioProcessorValueTreeState& tree, Sender sender);
+    ~ParameterSync() override;
+
+    // Everything the webview needs to build its controls in one reply: slot order, IDs, names,
+    // ranges, defaults, choice lists and current values, all in plain (denormalised) units
+    auto getMetadata() const -> var;
+    auto applyBatch(const Array<var>& operations) -> void;
+
+    auto getNumSlots() const -> int;
+    auto getParameter(int slot) const -> RangedAudioParameter*;
+
+private:
+    std::vector<RangedAudioParameter*> parameters;
+    std::vector<int> slotForIndex;
+    std::vector<bool> openGestures;
+    std::atomic<uint64> dirtySlots{0};
+    int applyingSlot = -1;
+    Sender sender;
+
+    auto parameterValueChanged(int parameterIndex, float newValue) -> void override;
+    auto parameterGestureChanged(int parameterIndex, bool gestureIsStarting) -> void override;
+    auto timerCallback() -> void override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterSync)
+};
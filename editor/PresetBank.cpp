@@ -0,0 +1,193 @@
+#include "PresetBank.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+static_assert(std::endian::native == std::endian::little, "PresetBank maps the file directly and assumes a little-endian host");
+
+template <typename T>
+static auto readStruct(const uint8* data, size_t offset) -> T {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+auto PresetBank::open(const File& file) -> std::unique_ptr<PresetBank> {
+    if (!file.existsAsFile()) return nullptr;
+
+    std::unique_ptr<PresetBank> bank{new PresetBank()};
+    bank->mappedFile = std::make_unique<MemoryMappedFile>(file, MemoryMappedFile::readOnly);
+
+    auto* address = bank->mappedFile->getData();
+    auto size = bank->mappedFile->getSize();
+    if (address == nullptr || size < sizeof(Header)) return nullptr;
+
+    bank->data = static_cast<const uint8*>(address);
+    bank->header = readStruct<Header>(bank->data, 0);
+
+    if (!bank->validate(size)) return nullptr;
+    return bank;
+}
+
+auto PresetBank::validate(size_t size) const -> bool {
+    if (std::memcmp(this->header.magic, PresetBank::magic, sizeof(PresetBank::magic)) != 0) return false;
+    if (this->header.version != PresetBank::formatVersion) return false;
+
+    auto fits = [size](uint64 offset, uint64 count, uint64 elementSize) {
+        return offset <= size && count * elementSize <= size - offset;
+    };
+
+    auto numPresets = static_cast<uint64>(this->header.numPresets);
+    auto numParameters = static_cast<uint64>(this->header.numParameters);
+
+    if (!fits(this->header.keysOffset, numParameters, sizeof(KeyEntry))) return false;
+    if (!fits(this->header.indexOffset, numPresets, sizeof(IndexEntry))) return false;
+    if (!fits(this->header.recordsOffset, numPresets * numParameters, sizeof(float))) return false;
+    if (!fits(this->header.stringsOffset, this->header.stringsSize, 1)) return false;
+
+    // Every string reference is checked once here so the accessors can stay branch free
+    auto stringFits = [this](uint32 offset, uint32 length) {
+        return static_cast<uint64>(offset) + length <= this->header.stringsSize;
+    };
+
+    for (uint32 parameter = 0; parameter < this->header.numParameters; parameter++) {
+        auto key = readStruct<KeyEntry>(this->data, this->header.keysOffset + parameter * sizeof(KeyEntry));
+        if (!stringFits(key.offset, key.length)) return false;
+    }
+
+    for (uint32 preset = 0; preset < this->header.numPresets; preset++) {
+        auto entry = readStruct<IndexEntry>(this->data, this->header.indexOffset + preset * sizeof(IndexEntry));
+        if (!stringFits(entry.nameOffset, entry.nameLength) || !stringFits(entry.authorOffset, entry.authorLength)) return false;
+        if (!stringFits(entry.folderOffset, entry.folderLength)) return false;
+    }
+
+    return true;
+}
+
+auto PresetBank::write(const File& file, const StringArray& keys, std::vector<Preset> presets) -> bool {
+    std::sort(presets.begin(), presets.end(), [](const Preset& a, const Preset& b) {
+        return std::strcmp(a.name.toRawUTF8(), b.name.toRawUTF8()) < 0;
+    });
+
+    MemoryOutputStream strings;
+
+    auto addString = [&strings](const String& text) -> KeyEntry {
+        auto offset = static_cast<uint32>(strings.getDataSize());
+        auto length = static_cast<uint32>(text.getNumBytesAsUTF8());
+        strings.write(text.toRawUTF8(), length);
+        return {offset, length};
+    };
+
+    Header header{};
+    std::memcpy(header.magic, PresetBank::magic, sizeof(PresetBank::magic));
+    header.version = PresetBank::formatVersion;
+    header.numPresets = static_cast<uint32>(presets.size());
+    header.numParameters = static_cast<uint32>(keys.size());
+    header.keysOffset = sizeof(Header);
+    header.indexOffset = header.keysOffset + header.numParameters * static_cast<uint32>(sizeof(KeyEntry));
+    header.recordsOffset = header.indexOffset + header.numPresets * static_cast<uint32>(sizeof(IndexEntry));
+    header.stringsOffset = header.recordsOffset + header.numPresets * header.numParameters * static_cast<uint32>(sizeof(float));
+
+    MemoryOutputStream keyTable;
+    for (const auto& key : keys) {
+        auto entry = addString(key);
+        keyTable.write(&entry, sizeof(entry));
+    }
+
+    MemoryOutputStream index;
+    MemoryOutputStream records;
+
+    for (const auto& preset : presets) {
+        auto name = addString(preset.name);
+        auto author = addString(preset.author);
+        auto folder = addString(preset.folder);
+        IndexEntry entry{name.offset, name.length, author.offset, author.length, folder.offset, folder.length};
+        index.write(&entry, sizeof(entry));
+
+        for (int parameter = 0; parameter < keys.size(); parameter++) {
+            auto slot = static_cast<size_t>(parameter);
+            float value = slot < preset.values.size() ? preset.values[slot] : std::numeric_limits<float>::quiet_NaN();
+            records.write(&value, sizeof(value));
+        }
+    }
+
+    header.stringsSize = static_cast<uint32>(strings.getDataSize());
+
+    TemporaryFile temporary{file};
+    {
+        FileOutputStream output{temporary.getFile()};
+        if (!output.openedOk()) return false;
+
+        output.write(&header, sizeof(header));
+        output.write(keyTable.getData(), keyTable.getDataSize());
+        output.write(index.getData(), index.getDataSize());
+        output.write(records.getData(), records.getDataSize());
+        output.write(strings.getData(), strings.getDataSize());
+        output.flush();
+
+        if (output.getStatus().failed()) return false;
+    }
+
+    return temporary.overwriteTargetFileWithTemporary();
+}
+
+auto PresetBank::getNumPresets() const -> int {
+    return static_cast<int>(this->header.numPresets);
+}
+
+auto PresetBank::getNumParameters() const -> int {
+    return static_cast<int>(this->header.numParameters);
+}
+
+auto PresetBank::getParameterKey(int parameter) const -> std::string_view {
+    auto offset = this->header.keysOffset + static_cast<uint32>(parameter) * sizeof(KeyEntry);
+    auto key = readStruct<KeyEntry>(this->data, offset);
+    return this->getString(key.offset, key.length);
+}
+
+auto PresetBank::getIndexEntry(int preset) const -> IndexEntry {
+    jassert(preset >= 0 && preset < this->getNumPresets());
+    auto offset = this->header.indexOffset + static_cast<uint32>(preset) * sizeof(IndexEntry);
+    return readStruct<IndexEntry>(this->data, offset);
+}
+
+auto PresetBank::getString(uint32 offset, uint32 length) const -> std::string_view {
+    return {reinterpret_cast<const char*>(this->data + this->header.stringsOffset + offset), length};
+}
+
+auto PresetBank::getName(int preset) const -> std::string_view {
+    auto entry = this->getIndexEntry(preset);
+    return this->getString(entry.nameOffset, entry.nameLength);
+}
+
+auto PresetBank::getAuthor(int preset) const -> std::string_view {
+    auto entry = this->getIndexEntry(preset);
+    return this->getString(entry.authorOffset, entry.authorLength);
+}
+
+auto PresetBank::getFolder(int preset) const -> std::string_view {
+    auto entry = this->getIndexEntry(preset);
+    return this->getString(entry.folderOffset, entry.folderLength);
+}
+
+auto PresetBank::getValue(int preset, int parameter) const -> float {
+    jassert(parameter >= 0 && parameter < this->getNumParameters());
+    auto record = static_cast<size_t>(preset) * this->header.numParameters + static_cast<size_t>(parameter);
+    return readStruct<float>(this->data, this->header.recordsOffset + record * sizeof(float));
+}
+
+auto PresetBank::findPreset(std::string_view name) const -> int {
+    int low = 0;
+    int high = this->getNumPresets();
+
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (this->getName(middle) < name) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low < this->getNumPresets() && this->getName(low) == name ? low : -1;
+}
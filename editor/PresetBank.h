@@ -0,0 +1,88 @@
+#pragma once
+#include <JuceHeader.h>
+#include <string_view>
+
+/*
+ * Single-file preset bank, all integers little-endian:
+ *
+ *   header      magic, version, counts and section offsets (PresetBank::Header)
+ *   keys        numParameters x {offset, length} into the string table, the parameter ID of each record column
+ *   index       numPresets x {name, author, folder} as offset/length pairs, sorted by name bytes
+ *   records     numPresets x numParameters normalised float32 values, NaN when the preset left it unset
+ *   strings     UTF-8 text referenced by the key and index tables
+ *
+ * Record i belongs to index entry i. The folder is the preset's path relative to the exported folder,
+ * '/' separated and empty at the top level, so an import can rebuild the subfolders. The file is memory mapped read-only, so browsing only pages in
+ * the index and the records that are actually read.
+ */
+class PresetBank {
+public:
+    static constexpr char magic[8] = {'G', 'B', 'P', 'B', 'A', 'N', 'K', '1'};
+    static constexpr uint32 formatVersion = 2;
+    static constexpr const char* fileExtension = ".gbbank";
+
+    struct Header {
+        char magic[8];
+        uint32 version;
+        uint32 numPresets;
+        uint32 numParameters;
+        uint32 keysOffset;
+        uint32 indexOffset;
+        uint32 recordsOffset;
+        uint32 stringsOffset;
+        uint32 stringsSize;
+    };
+
+    struct IndexEntry {
+        uint32 nameOffset;
+        uint32 nameLength;
+        uint32 authorOffset;
+        uint32 authorLength;
+        uint32 folderOffset;
+        uint32 folderLength;
+    };
+
+    struct KeyEntry {
+        uint32 offset;
+        uint32 length;
+    };
+
+    struct Preset {
+        String name;
+        String author;
+        String folder;
+        std::vector<float> values;
+    };
+
+    static_assert(sizeof(Header) == 40 && sizeof(IndexEntry) == 24 && sizeof(KeyEntry) == 8);
+
+    // Returns nullptr when the file is missing, not a bank or fails the bounds checks
+    static auto open(const File& file) -> std::unique_ptr<PresetBank>;
+
+    // Sorts the presets by name and writes the bank, values are normalised in the order of keys
+    static auto write(const File& file, const StringArray& keys, std::vector<Preset> presets) -> bool;
+
+    auto getNumPresets() const -> int;
+    auto getNumParameters() const -> int;
+    auto getParameterKey(int parameter) const -> std::string_view;
+    auto getName(int preset) const -> std::string_view;
+    auto getAuthor(int preset) const -> std::string_view;
+    auto getFolder(int preset) const -> std::string_view;
+    auto getValue(int preset, int parameter) const -> float;
+
+    // Binary search on the sorted index, -1 when there is no preset with that exact name
+    auto findPreset(std::string_view name) const -> int;
+
+private:
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    const uint8* data = nullptr;
+    Header header{};
+
+    PresetBank() = default;
+
+    auto getIndexEntry(int preset) const -> IndexEntry;
+    auto getString(uint32 offset, uint32 length) const -> std::string_view;
+    auto validate(size_t size) const -> bool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
@@ -2,16 +2,64 @@
 #include "Functions.hpp"
 #include "Settings.hpp"
 #include "ParameterIDs.hpp"
+#include "PresetParser.hpp"
 #include "EventEmitter.hpp"
 #include "NativeMenuBridge.h"
+#include "Trace.hpp"
+#include "FactoryPrograms.h"
 
-PresetManager::PresetManager(AudioProcessorValueTreeState& tree) : tree(tree) {
-    this->loadFactoryPresets();
-    this->loadUserPresets();
+PresetManager::PresetManager(AudioProcessorValueTreeState& tree) : tree(tree) {}
+
+auto PresetManager::ensureFactoryPresets() -> void {
+    if (this->factoryPresetsLoaded.load(std::memory_order_acquire)) return;
+
+    const ScopedLock lock{this->factoryLock};
+    if (!this->factoryPresetsLoaded.load(std::memory_order_relaxed)) this->loadFactoryPresets();
+}
+
+auto PresetManager::getNumFactoryPrograms() -> int {
+    return static_cast<int>(std::size(factoryProgramNames));
 }
 
+auto PresetManager::getFactoryProgramName(int index) -> String {
+    if (index < 0 || index >= PresetManager::getNumFactoryPrograms()) return {};
+    return String::fromUTF8(factoryProgramNames[static_cast<size_t>(index)]);
+}
+
+auto PresetManager::ensureUserPresets() -> void {
+    if (!this->userPresetsLoaded && !this->userScanPending) this->loadUserPresets();
+}
+
+auto PresetManager::whenUserPresetsReady(std::function<void()> callback) -> void {
+    this->ensureUserPresets();
+
+    if (this->userScanPending) {
+        this->userPresetWaiters.push_back(std::move(callback));
+        return;
+    }
+    callback();
+}
+
+auto PresetManager::finishUserScan() -> void {
+    this->userPresetsLoaded = true;
+    this->userScanPending = false;
+
+    // A waiter may start another scan, so the queue is swapped out before any of them run
+    auto waiters = std::exchange(this->userPresetWaiters, {});
+    for (auto& waiter : waiters) waiter();
+}
+
+#if JUCE_WEB_BROWSER
+
 auto PresetManager::openPresetMenu([[maybe_unused]] const Array<var>& args, 
     WebBrowserComponent::NativeFunctionCompletion completion) -> void {
+        // The menu opens once the user folder scan is done, so it never lists a partial library
+        this->ensureFactoryPresets();
+        this->whenUserPresetsReady([this, completion] { this->showPresetMenu(completion); });
+}
+
+auto PresetManager::showPresetMenu(WebBrowserComponent::NativeFunctionCompletion completion) -> void {
+        if (this->presetMenuStale) this->rebuildPresetMenu();
 
         std::map<int, std::string> items = {
             {1, "Init Preset"},
@@ -25,19 +73,34 @@ auto PresetManager::openPresetMenu([[maybe_unused]] const Array<var>& args,
         if (!rawUserFolder.isEmpty()) {
             userFolder = File{rawUserFolder}.getFileName().toStdString();
             items.insert(std::make_pair(5, "Remove User Folder"));
+            items.insert(std::make_pair(6, "Import Bank"));
+            items.insert(std::make_pair(7, "Export Bank"));
         }
 
-        int factoryID = static_cast<int>(items.size()) + 1;
-        std::map<int, std::string> factoryItems;
-        for (int i = 0; i < static_cast<int>(factoryPresetNames.size()); i++) {
-            factoryItems[factoryID + i] = this->factoryPresetNames[static_cast<size_t>(i)].toStdString();
-        }
+        // Preset IDs are firstID + index into the name lists, nothing is enumerated up front
+        int factoryID = PresetManager::factoryMenuID;
+        int userContentID = this->getUserMenuID();
 
-        int userContentID = factoryID + static_cast<int>(factoryItems.size()) + 1;
-        std::map<int, std::string> userItems;
-        for (int i = 0; i < static_cast<int>(userPresetNames.size()); i++) {
-            userItems[userContentID + i] = this->userPresetNames[static_cast<size_t>(i)].toStdString();
-        }
+        int currentID = -1;
+        if (this->presetFolder == "factory") currentID = factoryID + this->presetIndex;
+        if (this->presetFolder == "user") currentID = userContentID + this->presetIndex;
+
+        // The open menu reads this snapshot, so a user folder scan finishing meanwhile can't change it underneath
+        auto menu = this->presetMenu;
+        bool hasFactory = !this->factoryPresetNames.empty();
+        int factoryHandle = this->factoryMenuHandle;
+        int userHandle = this->userMenuHandle;
+
+        NativeMenuProvider provider = [menu, items, userFolder, currentID, hasFactory, factoryHandle, userHandle](int handle) {
+            if (handle != 0) return menu->getItems(handle, currentID);
+
+            std::vector<NativeMenuItem> rootItems;
+            for (const auto& [id, label] : items) rootItems.push_back({id, label, false, -1});
+
+            if (hasFactory) rootItems.push_back({0, "Factory", false, factoryHandle});
+            if (!userFolder.empty()) rootItems.push_back({0, userFolder, false, userHandle});
+            return rootItems;
+        };
 
         auto menuClick = [this, completion](std::string action){
             if (action == "Init Preset") {
@@ -57,164 +120,181 @@ auto PresetManager::openPresetMenu([[maybe_unused]] const Array<var>& args,
                 this->addUserFolder();
             } else if (action == "Remove User Folder") {
                 this->removeUserFolder();
+            } else if (action == "Import Bank") {
+                this->importBankFromFile();
+            } else if (action == "Export Bank") {
+                this->exportBankToFile();
             }
         };
 
-        auto presetClick = [this, completion](int presetIdx) {
-            if (presetIdx >= 0 && presetIdx < static_cast<int>(this->factoryPresets.size())) {
-                auto presetName = this->factoryPresetNames[static_cast<size_t>(presetIdx)];
-                auto json = this->factoryPresets[presetName];
+        auto presetClick = [this, menu, completion](const String& folder, int presetIdx, const String& presetName) {
+            auto& names = folder == "factory" ? this->factoryPresetNames : this->userPresetNames;
+            auto& presets = folder == "factory" ? this->factoryPresets : this->userPresets;
+
+            // The library may have been rescanned while the menu was open, then the pick is found again by name
+            if (presetIdx < 0 || presetIdx >= static_cast<int>(names.size()) || names[static_cast<size_t>(presetIdx)] != presetName) {
+                auto it = std::find(names.begin(), names.end(), presetName);
+                presetIdx = it == names.end() ? -1 : static_cast<int>(std::distance(names.begin(), it));
+            }
+
+            if (presetIdx >= 0) {
+                auto json = presets[presetName];
                 this->loadPreset(json);
                 this->currentPresetName = presetName;
                 this->presetIndex = presetIdx;
-                this->presetFolder = "factory";
+                this->presetFolder = folder;
                 EventEmitter::instance().emitEvent("presetChanged", this->currentPresetName);
                 completion(this->currentPresetName);
             }
         };
 
-        auto userPresetClick = [this, completion](int presetIdx) {
-            if (presetIdx >= 0 && presetIdx < static_cast<int>(this->userPresets.size())) {
-                auto presetName = this->userPresetNames[static_cast<size_t>(presetIdx)];
-                auto json = this->userPresets[presetName];
-                this->loadPreset(json);
-                this->currentPresetName = presetName;
-                this->presetIndex = presetIdx;
-                this->presetFolder = "user";
-                EventEmitter::instance().emitEvent("presetChanged", this->currentPresetName);
-                completion(this->currentPresetName);
+        auto menuResult = [menu, items, menuClick, presetClick, factoryID, userContentID](int resultID) {
+            if (resultID == 0) return;
+
+            if (resultID < factoryID) {
+                auto it = items.find(resultID);
+                if (it != items.end()) {
+                    menuClick(it->second);
+                }
+            } else if (resultID >= factoryID && resultID < userContentID) {
+                presetClick("factory", resultID - factoryID, menu->getPresetName(resultID));
+            } else if (resultID >= userContentID) {
+                presetClick("user", resultID - userContentID, menu->getPresetName(resultID));
             }
         };
 
         #if JUCE_MAC
-            showNativeMacMenu(items, factoryItems, userItems, userFolder,
-                this->currentPresetName.toStdString(), this->presetFolder.toStdString(), [items, menuClick, presetClick, 
-                userPresetClick, factoryID, userContentID](int resultID) {
-                if (resultID == 0) return;
-
-                if (resultID < factoryID) {
-                    auto it = items.find(resultID);
-                    if (it != items.end()) {
-                        menuClick(it->second);
-                    }
-                } else if (resultID >= factoryID && resultID < userContentID) {
-                    int presetIdx = resultID - factoryID;
-                    presetClick(presetIdx);
-                } else if (resultID >= userContentID) {
-                    int presetIdx = resultID - userContentID;
-                    userPresetClick(presetIdx);
-                }
-            });
+            showNativeMacMenu(provider, menuResult);
         #elif _WIN32
-            showNativeWinMenu(items, factoryItems, userItems, userFolder,
-                this->currentPresetName.toStdString(), this->presetFolder.toStdString(),
-                [items, menuClick, presetClick, userPresetClick, factoryID, userContentID](int resultID) {
-                    if (resultID == 0) return;
-        
-                    if (resultID < factoryID) {
-                        auto it = items.find(resultID);
-                        if (it != items.end()) {
-                            menuClick(it->second);
-                        }
-                    } else if (resultID >= factoryID && resultID < userContentID) {
-                        int presetIdx = resultID - factoryID;
-                        presetClick(presetIdx);
-                    } else if (resultID >= userContentID) {
-                        int presetIdx = resultID - userContentID;
-                        userPresetClick(presetIdx);
-                    }
-                });
+            showNativeWinMenu(provider, menuResult);
         #else
-            PopupMenu menu;
-            for (const auto& [id, label] : items) {
-                menu.addItem(id, label);
-            }
+            this->showPopupMenuLevel(0, menu, provider, menuResult);
+        #endif
+}
 
-            PopupMenu factoryMenu;
-            for (int i = 0; i < static_cast<int>(factoryPresetNames.size()); i++) {
-                int itemID = factoryID + i;
-                auto name = this->factoryPresetNames[static_cast<size_t>(i)];
-                bool isTicked = (this->presetFolder == "factory" && this->currentPresetName == name);
-                factoryMenu.addItem(itemID, this->factoryPresetNames[static_cast<size_t>(i)], true, isTicked);
-            }
-            menu.addSubMenu("Factory", factoryMenu);
-
-            if (!userFolder.empty()) {
-                PopupMenu userMenu;
-                for (int i = 0; i < static_cast<int>(userPresetNames.size()); i++) {
-                    int itemID = userContentID + i;
-                    auto name = this->userPresetNames[static_cast<size_t>(i)];
-                    bool isTicked = (this->presetFolder == "user" && this->currentPresetName == name);
-                    userMenu.addItem(itemID, this->userPresetNames[static_cast<size_t>(i)], true, isTicked);
-                }
-                menu.addSubMenu(userFolder, userMenu);
+auto PresetManager::showPopupMenuLevel(int handle, std::shared_ptr<const PresetMenu> presetMenuSnapshot,
+    NativeMenuProvider provider, std::function<void(int)> onResult) -> void {
+    // PopupMenu has no lazy submenus, so one level below this one is filled in and anything
+    // deeper (subfolders, pages) reopens the menu at that level when picked
+    int drillDownID = presetMenuSnapshot->getEndID() + 1;
+    auto drillDown = std::make_shared<std::vector<int>>();
+
+    std::function<void(PopupMenu&, int, int)> addLevel = [&](PopupMenu& target, int level, int depth) {
+        for (const auto& item : provider(level)) {
+            if (item.submenu < 0) {
+                target.addItem(item.id, item.label, true, item.checked);
+            } else if (depth == 0) {
+                PopupMenu submenu;
+                addLevel(submenu, item.submenu, depth + 1);
+                target.addSubMenu(item.label, submenu);
+            } else {
+                drillDown->push_back(item.submenu);
+                target.addItem(drillDownID + static_cast<int>(drillDown->size()) - 1, item.label + " ...");
             }
+        }
+    };
 
-            auto mousePos = Desktop::getMousePosition();
-            
-            auto options = PopupMenu::Options()
-                .withPreferredPopupDirection(PopupMenu::Options::PopupDirection::upwards)
-                .withTargetScreenArea(Rectangle<int> {mousePos.x - 60, mousePos.y - 5, 1, 1});
-
-            PopupMenu::dismissAllActiveMenus();
-            menu.showMenuAsync(options, [items, menuClick, presetClick, userPresetClick, factoryID, 
-                userContentID, completion](int resultID) {
-                if (resultID == 0) return;
-
-                if (resultID < factoryID) {
-                    auto it = items.find(resultID);
-                    if (it != items.end()) {
-                        auto action = it->second;
-                        menuClick(action);
-                    }
-                } else if (resultID >= factoryID && resultID < userContentID) {
-                    int presetIdx = resultID - factoryID;
-                    presetClick(presetIdx);
-                } else if (resultID >= userContentID) {
-                    int presetIdx = resultID - userContentID;
-                    userPresetClick(presetIdx);
-                }
-            });
-        #endif
+    PopupMenu menu;
+    if (handle != 0) menu.addSectionHeader(presetMenuSnapshot->getLabel(handle));
+    addLevel(menu, handle, 0);
+
+    auto mousePos = Desktop::getMousePosition();
+    
+    auto options = PopupMenu::Options()
+        .withPreferredPopupDirection(PopupMenu::Options::PopupDirection::upwards)
+        .withTargetScreenArea(Rectangle<int> {mousePos.x - 60, mousePos.y - 5, 1, 1});
+
+    PopupMenu::dismissAllActiveMenus();
+    menu.showMenuAsync(options, [this, presetMenuSnapshot, provider, onResult, drillDown, drillDownID](int resultID) {
+        if (resultID >= drillDownID) {
+            auto level = static_cast<size_t>(resultID - drillDownID);
+            if (level < drillDown->size()) this->showPopupMenuLevel((*drillDown)[level], presetMenuSnapshot, provider, onResult);
+            return;
+        }
+        onResult(resultID);
+    });
 }
 
 auto PresetManager::prevPreset([[maybe_unused]] const Array<var>& args,
     WebBrowserComponent::NativeFunctionCompletion completion) -> void {
-        if (this->presetFolder == "factory") {
-            if (this->factoryPresetNames.empty()) return;
-            this->presetIndex = (this->presetIndex - 1 + static_cast<int>(factoryPresetNames.size())) % static_cast<int>(factoryPresetNames.size());
-        }
+        this->ensureFactoryPresets();
 
-        if (this->presetFolder == "user") {
-            if (this->userPresetNames.empty()) return;
-            this->presetIndex = (this->presetIndex - 1 + static_cast<int>(userPresetNames.size())) % static_cast<int>(userPresetNames.size());
-        }
+        this->whenUserPresetsReady([this, completion] {
+            if (this->presetFolder == "factory") {
+                if (this->factoryPresetNames.empty()) return completion(this->currentPresetName);
+                this->presetIndex = (this->presetIndex - 1 + static_cast<int>(factoryPresetNames.size())) % static_cast<int>(factoryPresetNames.size());
+            }
 
-        auto presetName = this->setPreset(this->presetIndex);
-        return completion(presetName);
+            if (this->presetFolder == "user") {
+                if (this->userPresetNames.empty()) return completion(this->currentPresetName);
+                this->presetIndex = (this->presetIndex - 1 + static_cast<int>(userPresetNames.size())) % static_cast<int>(userPresetNames.size());
+            }
+
+            auto presetName = this->setPreset(this->presetIndex);
+            return completion(presetName);
+        });
 }
 
 auto PresetManager::nextPreset([[maybe_unused]] const Array<var>& args,
     WebBrowserComponent::NativeFunctionCompletion completion) -> void {
-        if (this->presetFolder == "factory") {
-            if (this->factoryPresetNames.empty()) return;
-            this->presetIndex = (this->presetIndex + 1) % static_cast<int>(factoryPresetNames.size());
-        }
+        this->ensureFactoryPresets();
 
-        if (this->presetFolder == "user") {
-            if (this->userPresetNames.empty()) return;
-            this->presetIndex = (this->presetIndex + 1) % static_cast<int>(userPresetNames.size());
-        }
+        this->whenUserPresetsReady([this, completion] {
+            if (this->presetFolder == "factory") {
+                if (this->factoryPresetNames.empty()) return completion(this->currentPresetName);
+                this->presetIndex = (this->presetIndex + 1) % static_cast<int>(factoryPresetNames.size());
+            }
+
+            if (this->presetFolder == "user") {
+                if (this->userPresetNames.empty()) return completion(this->currentPresetName);
+                this->presetIndex = (this->presetIndex + 1) % static_cast<int>(userPresetNames.size());
+            }
 
-        auto presetName = this->setPreset(this->presetIndex);
-        return completion(presetName);
+            auto presetName = this->setPreset(this->presetIndex);
+            return completion(presetName);
+        });
 }
 
+auto PresetManager::searchPresets(const Array<var>& args,
+    WebBrowserComponent::NativeFunctionCompletion completion) -> void {
+        auto query = args.size() > 0 ? args[0].toString() : String{};
+        int limit = jlimit(1, 500, args.size() > 1 ? static_cast<int>(args[1]) : 50);
+
+        this->ensureFactoryPresets();
+        this->whenUserPresetsReady([this, completion, query, limit] {
+            completion(this->searchPresets(query, limit));
+        });
+}
+
+auto PresetManager::selectPreset(const Array<var>& args,
+    WebBrowserComponent::NativeFunctionCompletion completion) -> void {
+        if (args.size() < 2) return completion(this->currentPresetName);
+
+        auto folder = args[0].toString();
+        int index = static_cast<int>(args[1]);
+
+        this->ensureFactoryPresets();
+        this->whenUserPresetsReady([this, completion, folder, index] {
+            auto& names = folder == "factory" ? this->factoryPresetNames : this->userPresetNames;
+            if ((folder != "factory" && folder != "user") || index < 0 || index >= static_cast<int>(names.size())) {
+                return completion(this->currentPresetName);
+            }
+
+            this->presetFolder = folder;
+            return completion(this->setPreset(index));
+        });
+}
+
+#endif
+
 auto PresetManager::setPreset(int _presetIndex) -> String {
+    // Host program changes land here too, so this never starts the user folder scan. User presets
+    // are only selected through the editor, which waits for the scan first
+    this->ensureFactoryPresets();
     this->presetIndex = _presetIndex;
 
     if (this->presetFolder == "factory") {
-        if (this->factoryPresetNames.empty()) return this->currentPresetName;
+        if (this->presetIndex < 0 || this->presetIndex >= static_cast<int>(this->factoryPresetNames.size())) return this->currentPresetName;
         auto presetName = factoryPresetNames[static_cast<size_t>(this->presetIndex)];
 
         auto it = factoryPresets.find(presetName);
@@ -226,7 +306,7 @@ auto PresetManager::setPreset(int _presetIndex) -> String {
     }
 
     if (this->presetFolder == "user") {
-        if (this->userPresetNames.empty()) return this->currentPresetName;
+        if (this->presetIndex < 0 || this->presetIndex >= static_cast<int>(this->userPresetNames.size())) return this->currentPresetName;
         auto presetName = userPresetNames[static_cast<size_t>(this->presetIndex)];
 
         auto it = userPresets.find(presetName);
@@ -252,16 +332,24 @@ auto PresetManager::loadPresetFromFile(std::function<void()> onComplete) -> void
     loadDialog->launchAsync(FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles,
         [this, loadDialog, onComplete](const FileChooser& picker) {
             auto file = picker.getResult();
-            if (file.existsAsFile()) {
-                Settings::setSettingKey("loadDirectory", file.getParentDirectory().getFullPathName());
-                auto jsonString = file.loadFileAsString();
-                auto presetName = this->loadPreset(jsonString);
-
-                this->currentPresetName = presetName;
-                this->presetIndex = 0;
-                this->presetFolder = "none";
-                onComplete();
-            }
+            if (file == File{}) return;
+
+            Settings::setSettingKey("loadDirectory", file.getParentDirectory().getFullPathName());
+
+            // Read and parse on the I/O thread, the parameters are only touched once it is back here
+            this->ioWorker.submit("load", [this, file, onComplete](const IOWorker::Token&) -> IOWorker::Completion {
+                TRACE_SCOPE("PresetManager::loadPresetFromFile");
+                auto preset = std::make_shared<ParsedPreset>();
+                if (!PresetParser::parse(file.loadFileAsString(), *preset) || !preset->hasParameters) return nullptr;
+
+                return [this, preset, onComplete] {
+                    this->currentPresetName = this->applyPreset(*preset);
+                    this->presetIndex = 0;
+                    this->presetFolder = "none";
+                    EventEmitter::instance().emitEvent("presetChanged", this->currentPresetName);
+                    onComplete();
+                };
+            });
         }
     );
 }
@@ -295,8 +383,12 @@ auto PresetManager::savePresetToFile() -> void {
                     Settings::setSettingKey("saveAuthor", author);
                     Settings::setSettingKey("saveDirectory", file.getParentDirectory().getFullPathName());
                     auto jsonString = this->savePreset(name, author);
-                    file.replaceWithText(jsonString);
-                    file.revealToUser();
+
+                    this->ioWorker.submit("save", [file, jsonString](const IOWorker::Token&) -> IOWorker::Completion {
+                        TRACE_SCOPE("PresetManager::savePresetToFile");
+                        if (!file.replaceWithText(jsonString)) return nullptr;
+                        return [file] { file.revealToUser(); };
+                    });
                 }
             }
         );
@@ -316,11 +408,16 @@ auto PresetManager::savePresetToFile() -> void {
 }
 
 auto PresetManager::loadFactoryPresets() -> void {
+    TRACE_SCOPE("PresetManager::loadFactoryPresets");
     MemoryInputStream zipStream(BinaryData::presets_zip, BinaryData::presets_zipSize, false);
     ZipFile zip{zipStream};
 
     this->factoryPresetNames.clear();
+    this->factoryPresetAuthors.clear();
+    this->factoryPresetFolders.clear();
     this->factoryPresets.clear();
+    this->searchIndexStale = true;
+    this->presetMenuStale = true;
 
     for (int i = 0; i < zip.getNumEntries(); i++) {
         auto* entry = zip.getEntry(i);
@@ -331,10 +428,10 @@ auto PresetManager::loadFactoryPresets() -> void {
         if (inputStream == nullptr) continue;
         
         auto content = inputStream->readEntireStreamAsString();
-        auto json = JSON::parse(content);
+        ParsedPreset preset;
 
-        if (auto* obj = json.getDynamicObject()) {
-            auto presetName = obj->getProperty("name").toString();
+        if (PresetParser::parse(content, preset)) {
+            auto presetName = preset.name.toString();
             if (presetName.isEmpty()) {
                 auto entryFile = File::createFileWithoutCheckingPath(entry->filename);
                 presetName = entryFile.getFileNameWithoutExtension();
@@ -342,8 +439,13 @@ auto PresetManager::loadFactoryPresets() -> void {
 
             this->factoryPresets[presetName] = content;
             this->factoryPresetNames.push_back(presetName);
+            this->factoryPresetAuthors.push_back(preset.author.toString());
+            this->factoryPresetFolders.push_back(entry->filename.containsChar('/')
+                ? entry->filename.upToLastOccurrenceOf("/", false, false) : String{});
         }
     }
+
+    this->factoryPresetsLoaded.store(true, std::memory_order_release);
 }
 
 auto PresetManager::addUserFolder() -> void {
@@ -367,38 +469,140 @@ auto PresetManager::addUserFolder() -> void {
 
 auto PresetManager::removeUserFolder() -> void {
     Settings::setSettingKey("userFolder", "");
-    this->userPresetNames.clear();
-    this->userPresets.clear();
+    this->ioWorker.cancel("scan");
+    this->setUserLibrary({});
+    this->finishUserScan();
 }
 
-auto PresetManager::loadUserPresets() -> void {
-    this->userPresetNames.clear();
-    this->userPresets.clear();
+auto PresetManager::importBankFromFile() -> void {
+    auto userFolder = File{Settings::getSettingKey("userFolder", "").toString()};
+    if (!userFolder.isDirectory()) return;
 
-    auto userFolder = Settings::getSettingKey("userFolder", "").toString();
-    if (userFolder.isEmpty()) return;
+    auto directoryPath = Settings::getSettingKey("bankDirectory", Functions::getDownloadsFolder().getFullPathName());
+    auto openDialog = std::make_shared<FileChooser>(
+        "Import Bank", File{directoryPath}, "*" + String{PresetBank::fileExtension}
+    );
 
-    File userFolderDir{userFolder};
-    if (!userFolderDir.exists() || !userFolderDir.isDirectory()) return;
+    openDialog->launchAsync(FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles,
+        [this, openDialog, userFolder](const FileChooser& picker) {
+            auto bankFile = picker.getResult();
+            if (bankFile == File{}) return;
 
-    auto jsonFiles = userFolderDir.findChildFiles(File::TypesOfFileToFind::findFiles, false, "*.json");
+            Settings::setSettingKey("bankDirectory", bankFile.getParentDirectory().getFullPathName());
 
-    for (const auto& file : jsonFiles) {
-        auto content = file.loadFileAsString();
-        auto json = JSON::parse(content);
+            // The bank unpacks into a subfolder of the user folder, so it shows up as a submenu once rescanned
+            auto folder = userFolder.getNonexistentChildFile(Functions::cleanFilename(bankFile.getFileNameWithoutExtension()), "", false);
+
+            // Read the bank, turn values into text here on the message thread, then write the files
+            this->ioWorker.submit("bank", [this, bankFile, folder](const IOWorker::Token&) -> IOWorker::Completion {
+                auto presets = PresetManager::readBank(bankFile);
+                if (presets == nullptr) return nullptr;
 
-        if (auto* obj = json.getDynamicObject()) {
-            auto presetName = obj->getProperty("name").toString();
-            if (presetName.isEmpty()) presetName = file.getFileNameWithoutExtension();
+                return [this, presets, folder] {
+                    this->normalisedToText(*presets);
 
-            this->userPresets[presetName] = content;
-            this->userPresetNames.push_back(presetName);
+                    this->ioWorker.submit("bank", [this, presets, folder](const IOWorker::Token&) -> IOWorker::Completion {
+                        if (PresetManager::writePresetFolder(folder, *presets) <= 0) return nullptr;
+                        return [this] { this->loadUserPresets(); };
+                    });
+                };
+            });
+        }
+    );
+}
+
+auto PresetManager::exportBankToFile() -> void {
+    auto userFolder = File{Settings::getSettingKey("userFolder", "").toString()};
+    if (!userFolder.isDirectory()) return;
+
+    auto directoryPath = Settings::getSettingKey("bankDirectory", Functions::getDownloadsFolder().getFullPathName());
+    auto saveDialog = std::make_shared<FileChooser>(
+        "Export Bank", File{directoryPath}.getChildFile(userFolder.getFileName() + PresetBank::fileExtension)
+    );
+
+    saveDialog->launchAsync(FileBrowserComponent::saveMode | FileBrowserComponent::canSelectFiles,
+        [this, saveDialog, userFolder](const FileChooser& picker) {
+            auto bankFile = picker.getResult();
+            if (bankFile == File{}) return;
+
+            Settings::setSettingKey("bankDirectory", bankFile.getParentDirectory().getFullPathName());
+
+            // Read the presets, turn text into values here on the message thread, then write the bank
+            this->ioWorker.submit("bank", [this, userFolder, bankFile](const IOWorker::Token& token) -> IOWorker::Completion {
+                auto presets = PresetManager::readPresetFolder(userFolder, token);
+                if (presets == nullptr) return nullptr;
+
+                return [this, presets, bankFile] {
+                    this->textToNormalised(*presets);
+
+                    this->ioWorker.submit("bank", [presets, bankFile](const IOWorker::Token&) -> IOWorker::Completion {
+                        if (!PresetManager::writeBank(bankFile, std::move(*presets))) return nullptr;
+                        return [bankFile] { bankFile.revealToUser(); };
+                    });
+                };
+            });
         }
+    );
+}
+
+auto PresetManager::loadUserPresets() -> void {
+    auto userFolder = Settings::getSettingKey("userFolder", "").toString();
+    if (userFolder.isEmpty()) {
+        this->ioWorker.cancel("scan");
+        this->setUserLibrary({});
+        this->finishUserScan();
+        return;
     }
+
+    this->userScanPending = true;
+
+    // The current list stays up until the scan finishes, a newer scan cancels this one between files
+    this->ioWorker.submit("scan", [this, userFolder](const IOWorker::Token& token) -> IOWorker::Completion {
+        TRACE_SCOPE("PresetManager::loadUserPresets");
+        auto library = std::make_shared<PresetLibrary>();
+
+        File userFolderDir{userFolder};
+        if (userFolderDir.isDirectory()) {
+            // Subfolders become submenus, so the scan is recursive
+            for (const auto& entry : RangedDirectoryIterator{userFolderDir, true, "*.json", File::findFiles}) {
+                if (token.isCancelled()) return nullptr;
+
+                auto file = entry.getFile();
+                auto content = file.loadFileAsString();
+                ParsedPreset preset;
+
+                if (PresetParser::parse(content, preset)) {
+                    auto presetName = preset.name.toString();
+                    if (presetName.isEmpty()) presetName = file.getFileNameWithoutExtension();
+
+                    auto parent = file.getParentDirectory();
+                    library->presets[presetName] = content;
+                    library->names.push_back(presetName);
+                    library->authors.push_back(preset.author.toString());
+                    library->folders.push_back(parent == userFolderDir ? String{}
+                        : parent.getRelativePathFrom(userFolderDir).replaceCharacter('\\', '/'));
+                }
+            }
+        }
+
+        return [this, library] {
+            this->setUserLibrary(std::move(*library));
+            this->finishUserScan();
+        };
+    });
 }
 
-auto PresetManager::savePreset(const String& name, const String& author) -> String {
-    auto obj = std::make_unique<DynamicObject>();
+auto PresetManager::setUserLibrary(PresetLibrary library) -> void {
+    this->userPresets = std::move(library.presets);
+    this->userPresetNames = std::move(library.names);
+    this->userPresetAuthors = std::move(library.authors);
+    this->userPresetFolders = std::move(library.folders);
+    this->searchIndexStale = true;
+    this->presetMenuStale = true;
+}
+
+auto PresetManager::createPresetObject(const String& name, const String& author) -> DynamicObject::Ptr {
+    DynamicObject::Ptr obj{new DynamicObject()};
 
     obj->setProperty("plugin", JucePlugin_Name);
     obj->setProperty("version", JucePlugin_VersionString);
@@ -407,6 +611,11 @@ auto PresetManager::savePreset(const String& name, const String& author) -> Stri
     obj->setProperty("modified", Time::getCurrentTime().toISO8601(true));
     obj->setProperty("presetFormat", 1);
 
+    return obj;
+}
+
+auto PresetManager::savePreset(const String& name, const String& author) -> String {
+    auto obj = PresetManager::createPresetObject(name, author);
     auto parameters = std::make_unique<DynamicObject>();
 
     for (const auto& id : ParameterIDs::getStringKeys()) {
@@ -418,35 +627,34 @@ auto PresetManager::savePreset(const String& name, const String& author) -> Stri
     }
 
     obj->setProperty("parameters", var(parameters.release()));
-    auto json = var{obj.release()};
+    auto json = var{obj.get()};
 
     return JSON::toString(json);
 }
 
 auto PresetManager::loadPreset(const String& jsonStr) -> String {
-    auto parsed = JSON::fromString(jsonStr);
-    auto* obj = parsed.getDynamicObject();
-    if (obj == nullptr) return "";
+    TRACE_SCOPE("PresetManager::loadPreset");
+    ParsedPreset preset;
+    if (!PresetParser::parse(jsonStr, preset) || !preset.hasParameters) return "";
 
-    String presetName = "";
+    return this->applyPreset(preset);
+}
 
-    if (obj->hasProperty("name")) {
-        presetName = obj->getProperty("name").toString();
-    }
+auto PresetManager::applyPreset(const ParsedPreset& preset) -> String {
+    const auto& schema = PresetSchema::instance();
 
-    auto parameters = var{obj->getProperty("parameters")};
-    auto* paramObj = parameters.getDynamicObject();
-    if (paramObj == nullptr) return "";
+    for (size_t index = 0; index < schema.numParameters; index++) {
+        if (!preset.present[index]) continue;
 
-    for (const auto& property : paramObj->getProperties()) {
-        auto id = property.name.toString();
-        auto* param = this->tree.getParameter(id);
+        auto* param = this->tree.getParameter(schema.getKey(index));
+        if (param == nullptr) continue;
 
-        float value = param->getValueForText(property.value.toString());
+        float value = param->getValueForText(preset.values[index].toString());
         param->setValueNotifyingHost(value);
     }
 
-    return presetName;
+    this->presetGeneration.fetch_add(1, std::memory_order_release);
+    return preset.name.toString();
 }
 
 auto PresetManager::initPreset() -> void {
@@ -454,4 +662,218 @@ auto PresetManager::initPreset() -> void {
         auto* param = this->tree.getParameter(id);
         param->setValueNotifyingHost(param->getDefaultValue());
     }
+
+    this->presetGeneration.fetch_add(1, std::memory_order_release);
+}
+
+auto PresetManager::readPresetFolder(const File& folder, const IOWorker::Token& token) -> std::shared_ptr<BankPresets> {
+    TRACE_SCOPE("PresetManager::readPresetFolder");
+    if (!folder.isDirectory()) return nullptr;
+
+    const auto& schema = PresetSchema::instance();
+    auto presets = std::make_shared<BankPresets>();
+    std::set<String> names;
+    ParsedPreset parsed;
+
+    // Recursive like the user folder scan, so imported banks and other subfolders are kept
+    auto jsonFiles = folder.findChildFiles(File::TypesOfFileToFind::findFiles, true, "*.json");
+    jsonFiles.sort();
+
+    for (const auto& file : jsonFiles) {
+        if (token.isCancelled()) return nullptr;
+        if (!PresetParser::parse(file.loadFileAsString(), parsed) || !parsed.hasParameters) continue;
+
+        auto name = parsed.name.toString();
+        if (name.isEmpty()) name = file.getFileNameWithoutExtension();
+
+        // Presets are looked up by name, so the first file wins like it does for user folders
+        if (!names.insert(name).second) continue;
+
+        auto parent = file.getParentDirectory();
+        BankPreset preset{name, parsed.author.toString(), parent == folder ? String{}
+            : parent.getRelativePathFrom(folder).replaceCharacter('\\', '/'), {}, {}};
+        preset.texts.resize(schema.numParameters);
+
+        for (size_t index = 0; index < schema.numParameters; index++) {
+            if (parsed.present[index]) preset.texts[index] = parsed.values[index].toString();
+        }
+
+        presets->push_back(std::move(preset));
+    }
+
+    return presets;
+}
+
+auto PresetManager::textToNormalised(BankPresets& presets) -> void {
+    JUCE_ASSERT_MESSAGE_THREAD
+    const auto& schema = PresetSchema::instance();
+
+    for (auto& preset : presets) {
+        preset.values.assign(schema.numParameters, std::numeric_limits<float>::quiet_NaN());
+
+        for (size_t index = 0; index < schema.numParameters; index++) {
+            if (preset.texts[index].isEmpty()) continue;
+
+            auto* param = this->tree.getParameter(schema.getKey(index));
+            if (param != nullptr) preset.values[index] = param->getValueForText(preset.texts[index]);
+        }
+    }
+}
+
+auto PresetManager::writeBank(const File& bankFile, BankPresets presets) -> bool {
+    TRACE_SCOPE("PresetManager::writeBank");
+    const auto& schema = PresetSchema::instance();
+    StringArray keys;
+    for (size_t index = 0; index < schema.numParameters; index++) keys.add(schema.getKey(index));
+
+    std::vector<PresetBank::Preset> bankPresets;
+    bankPresets.reserve(presets.size());
+
+    for (auto& preset : presets) {
+        bankPresets.push_back({std::move(preset.name), std::move(preset.author), std::move(preset.folder), std::move(preset.values)});
+    }
+
+    return PresetBank::write(bankFile, keys, std::move(bankPresets));
+}
+
+auto PresetManager::readBank(const File& bankFile) -> std::shared_ptr<BankPresets> {
+    TRACE_SCOPE("PresetManager::readBank");
+    auto bank = PresetBank::open(bankFile);
+    if (bank == nullptr) return nullptr;
+
+    const auto& schema = PresetSchema::instance();
+    auto presets = std::make_shared<BankPresets>();
+
+    // Bank columns can be in any order or name parameters this build doesn't have
+    std::vector<int> slots;
+    for (int parameter = 0; parameter < bank->getNumParameters(); parameter++) {
+        slots.push_back(schema.indexOf(bank->getParameterKey(parameter)));
+    }
+
+    auto toString = [](std::string_view text) {
+        return String::fromUTF8(text.data(), static_cast<int>(text.size()));
+    };
+
+    for (int preset = 0; preset < bank->getNumPresets(); preset++) {
+        BankPreset entry{toString(bank->getName(preset)), toString(bank->getAuthor(preset)), toString(bank->getFolder(preset)), {}, {}};
+        entry.values.assign(schema.numParameters, std::numeric_limits<float>::quiet_NaN());
+
+        for (int parameter = 0; parameter < bank->getNumParameters(); parameter++) {
+            auto slot = slots[static_cast<size_t>(parameter)];
+            if (slot >= 0) entry.values[static_cast<size_t>(slot)] = bank->getValue(preset, parameter);
+        }
+
+        presets->push_back(std::move(entry));
+    }
+
+    return presets;
+}
+
+auto PresetManager::normalisedToText(BankPresets& presets) -> void {
+    JUCE_ASSERT_MESSAGE_THREAD
+    const auto& schema = PresetSchema::instance();
+
+    for (auto& preset : presets) {
+        preset.texts.assign(schema.numParameters, String{});
+
+        for (size_t index = 0; index < schema.numParameters; index++) {
+            if (std::isnan(preset.values[index])) continue;
+
+            auto* param = this->tree.getParameter(schema.getKey(index));
+            if (param != nullptr) preset.texts[index] = param->getText(preset.values[index], 0);
+        }
+    }
+}
+
+auto PresetManager::writePresetFolder(const File& folder, const BankPresets& presets) -> int {
+    TRACE_SCOPE("PresetManager::writePresetFolder");
+    if (!folder.createDirectory()) return -1;
+
+    const auto& schema = PresetSchema::instance();
+    int written = 0;
+
+    for (const auto& preset : presets) {
+        // Folder names come from the bank, so each part is cleaned and nothing can climb out of folder
+        auto directory = folder;
+        for (const auto& part : StringArray::fromTokens(preset.folder, "/", "")) {
+            auto cleaned = Functions::cleanFilename(part);
+            if (cleaned.isNotEmpty() && cleaned != "." && cleaned != "..") directory = directory.getChildFile(cleaned);
+        }
+
+        if (!directory.createDirectory()) continue;
+
+        auto obj = PresetManager::createPresetObject(preset.name, preset.author);
+        auto parameters = std::make_unique<DynamicObject>();
+
+        for (size_t index = 0; index < schema.numParameters; index++) {
+            if (preset.texts[index].isNotEmpty()) parameters->setProperty(schema.getKey(index), preset.texts[index]);
+        }
+
+        obj->setProperty("parameters", var(parameters.release()));
+
+        auto file = directory.getNonexistentChildFile(Functions::cleanFilename(preset.name), ".json", false);
+        if (file.replaceWithText(JSON::toString(var{obj.get()}))) written++;
+    }
+
+    return written;
+}
+
+auto PresetManager::rebuildSearchIndex() -> void {
+    TRACE_SCOPE("PresetManager::rebuildSearchIndex");
+    this->searchIndex.clear();
+
+    // Factory presets take the first entry numbers, user presets follow
+    for (size_t i = 0; i < this->factoryPresetNames.size(); i++) {
+        this->searchIndex.add(this->factoryPresetNames[i].toRawUTF8(), this->factoryPresetAuthors[i].toRawUTF8());
+    }
+
+    for (size_t i = 0; i < this->userPresetNames.size(); i++) {
+        this->searchIndex.add(this->userPresetNames[i].toRawUTF8(), this->userPresetAuthors[i].toRawUTF8());
+    }
+
+    this->searchIndex.finalise();
+    this->searchIndexStale = false;
+}
+
+auto PresetManager::searchPresets(const String& query, int limit) -> Array<var> {
+    TRACE_SCOPE("PresetManager::searchPresets");
+    this->ensureFactoryPresets();
+    this->ensureUserPresets();
+    if (this->searchIndexStale) this->rebuildSearchIndex();
+
+    Array<var> results;
+    auto numFactory = static_cast<int>(this->factoryPresetNames.size());
+
+    for (const auto& result : this->searchIndex.search(query.toRawUTF8(), limit)) {
+        bool factory = result.entry < numFactory;
+        auto index = static_cast<size_t>(factory ? result.entry : result.entry - numFactory);
+
+        auto obj = std::make_unique<DynamicObject>();
+        obj->setProperty("name", factory ? this->factoryPresetNames[index] : this->userPresetNames[index]);
+        obj->setProperty("author", factory ? this->factoryPresetAuthors[index] : this->userPresetAuthors[index]);
+        obj->setProperty("folder", factory ? "factory" : "user");
+        obj->setProperty("index", static_cast<int>(index));
+        results.add(var{obj.release()});
+    }
+
+    return results;
+}
+
+auto PresetManager::getUserMenuID() const -> int {
+    return PresetManager::factoryMenuID + static_cast<int>(this->factoryPresetNames.size()) + 1;
+}
+
+auto PresetManager::rebuildPresetMenu() -> void {
+    TRACE_SCOPE("PresetManager::rebuildPresetMenu");
+    // Menus that are still open keep the previous snapshot alive, this one replaces it for the next open
+    auto menu = std::make_shared<PresetMenu>();
+
+    auto userFolder = File{Settings::getSettingKey("userFolder", "").toString()}.getFileName();
+    this->factoryMenuHandle = menu->addSource("Factory", this->factoryPresetNames,
+        this->factoryPresetFolders, PresetManager::factoryMenuID);
+    this->userMenuHandle = menu->addSource(userFolder, this->userPresetNames,
+        this->userPresetFolders, this->getUserMenuID());
+
+    this->presetMenu = std::move(menu);
+    this->presetMenuStale = false;
 }
\ No newline at end of file
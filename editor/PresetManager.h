@@ -1,5 +1,11 @@
 #pragma once
 #include <JuceHeader.h>
+#include "PresetBank.h"
+#include "PresetSearchIndex.h"
+#include "PresetMenu.h"
+#include "IOWorker.hpp"
+
+struct ParsedPreset;
 
 class PresetManager {
 public:
@@ -9,22 +15,46 @@ public:
     auto savePresetToFile() -> void;
     auto loadPresetFromFile(std::function<void()> onComplete) -> void;
     auto loadFactoryPresets() -> void;
+    // Safe from any thread, the factory library is loaded once and never changes afterwards
+    auto ensureFactoryPresets() -> void;
     auto addUserFolder() -> void;
     auto removeUserFolder() -> void;
+    auto importBankFromFile() -> void;
+    auto exportBankToFile() -> void;
+    // Message thread only, the folder scan completes asynchronously
     auto loadUserPresets() -> void;
+    auto ensureUserPresets() -> void;
+    // Runs callback once the user library is loaded, straight away when no scan is pending
+    auto whenUserPresetsReady(std::function<void()> callback) -> void;
     auto setPreset(int presetIndex) -> String;
     auto savePreset(const String& name = "", const String& author = "") -> String;
     auto loadPreset(const String& jsonStr) -> String;
+    auto applyPreset(const ParsedPreset& preset) -> String;
     auto initPreset() -> void;
+
+    // Ranked {name, author, folder, index} objects over factory and user presets
+    auto searchPresets(const String& query, int limit) -> Array<var>;
+
+    // Host program count and names come from a table generated at configure time, nothing is unzipped
+    static auto getNumFactoryPrograms() -> int;
+    static auto getFactoryProgramName(int index) -> String;
         
-    auto openPresetMenu(const Array<var>& args, 
-        WebBrowserComponent::NativeFunctionCompletion completion) -> void;
+    #if JUCE_WEB_BROWSER
+        auto openPresetMenu(const Array<var>& args, 
+            WebBrowserComponent::NativeFunctionCompletion completion) -> void;
+
+        auto prevPreset(const Array<var>& args, 
+            WebBrowserComponent::NativeFunctionCompletion completion) -> void;
+
+        auto nextPreset(const Array<var>& args, 
+            WebBrowserComponent::NativeFunctionCompletion completion) -> void;
 
-    auto prevPreset(const Array<var>& args, 
-        WebBrowserComponent::NativeFunctionCompletion completion) -> void;
+        auto searchPresets(const Array<var>& args, 
+            WebBrowserComponent::NativeFunctionCompletion completion) -> void;
 
-    auto nextPreset(const Array<var>& args, 
-        WebBrowserComponent::NativeFunctionCompletion completion) -> void;
+        auto selectPreset(const Array<var>& args, 
+            WebBrowserComponent::NativeFunctionCompletion completion) -> void;
+    #endif
 
     String currentPresetName = "Default";
     std::map<String, String> factoryPresets;
@@ -33,9 +63,77 @@ public:
     std::vector<String> userPresetNames;
     int presetIndex = 0;
     String presetFolder = "none";
+    std::atomic<int> presetGeneration{0};
 
 private:
     AudioProcessorValueTreeState& tree;
+    CriticalSection factoryLock;
+    std::atomic<bool> factoryPresetsLoaded{false};
+    bool userPresetsLoaded = false;
+    bool userScanPending = false;
+    std::vector<std::function<void()>> userPresetWaiters;
+
+    std::vector<String> factoryPresetAuthors;
+    std::vector<String> userPresetAuthors;
+    PresetSearchIndex searchIndex;
+
+    // Atomic because loadFactoryPresets can set them on a host thread through setCurrentProgram
+    std::atomic<bool> searchIndexStale{true};
+
+    // Menu IDs 1-7 are the actions, factory presets start at 8 and user presets follow them
+    static constexpr int factoryMenuID = 8;
+    std::vector<String> factoryPresetFolders;
+    std::vector<String> userPresetFolders;
+    std::shared_ptr<const PresetMenu> presetMenu = std::make_shared<PresetMenu>();
+    int factoryMenuHandle = 0;
+    int userMenuHandle = 0;
+    std::atomic<bool> presetMenuStale{true};
+
+    struct PresetLibrary {
+        std::map<String, String> presets;
+        std::vector<String> names;
+        std::vector<String> authors;
+        std::vector<String> folders;
+    };
+
+    // One preset on its way into or out of a bank, slots follow PresetSchema. Jobs fill either the
+    // text or the normalised values from files, only the message thread converts between the two
+    struct BankPreset {
+        String name;
+        String author;
+        String folder;
+        std::vector<String> texts;
+        std::vector<float> values;
+    };
+
+    using BankPresets = std::vector<BankPreset>;
+
+    // I/O thread, these only touch the files and the data passed in
+    static auto readPresetFolder(const File& folder, const IOWorker::Token& token) -> std::shared_ptr<BankPresets>;
+    static auto writeBank(const File& bankFile, BankPresets presets) -> bool;
+    static auto readBank(const File& bankFile) -> std::shared_ptr<BankPresets>;
+    static auto writePresetFolder(const File& folder, const BankPresets& presets) -> int;
+
+    // Message thread, through the parameter tree
+    auto textToNormalised(BankPresets& presets) -> void;
+    auto normalisedToText(BankPresets& presets) -> void;
+
+    auto setUserLibrary(PresetLibrary library) -> void;
+    auto finishUserScan() -> void;
+    auto rebuildSearchIndex() -> void;
+    auto rebuildPresetMenu() -> void;
+    auto getUserMenuID() const -> int;
+
+    #if JUCE_WEB_BROWSER
+        auto showPresetMenu(WebBrowserComponent::NativeFunctionCompletion completion) -> void;
+        auto showPopupMenuLevel(int handle, std::shared_ptr<const PresetMenu> presetMenuSnapshot,
+            NativeMenuProvider provider, std::function<void(int)> onResult) -> void;
+    #endif
+
+    static auto createPresetObject(const String& name, const String& author) -> DynamicObject::Ptr;
+
+    // Last member, so pending jobs are cancelled before anything they complete into is destroyed
+    IOWorker ioWorker;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetManager)
 };
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "PresetMenu.h"
+
+auto PresetMenu::makeHandle(int node, int page) -> int {
+    // Page 0 is the folder view, page p > 0 lists the folder's (p - 1)th page of presets
+    return ((node + 1) << PresetMenu::pageBits) | page;
+}
+
+auto PresetMenu::addSource(const String& label, const std::vector<String>& names,
+    const std::vector<String>& folders, int firstID) -> int {
+    auto source = this->sources.size();
+    this->sources.push_back({firstID, names});
+
+    int rootNode = static_cast<int>(this->nodes.size());
+    this->nodes.push_back({label, source, {}, {}});
+
+    // Only folder paths are looked up by string, once per distinct folder rather than per preset
+    std::map<String, int> folderNodes{{"", rootNode}};
+
+    auto getFolderNode = [&](const String& path, auto&& self) -> int {
+        auto it = folderNodes.find(path);
+        if (it != folderNodes.end()) return it->second;
+
+        auto parentPath = path.containsChar('/') ? path.upToLastOccurrenceOf("/", false, false) : String{};
+        int parent = self(parentPath, self);
+
+        int node = static_cast<int>(this->nodes.size());
+        this->nodes.push_back({path.fromLastOccurrenceOf("/", false, false), source, {}, {}});
+        this->nodes[static_cast<size_t>(parent)].folders.push_back(node);
+
+        folderNodes[path] = node;
+        return node;
+    };
+
+    for (size_t index = 0; index < names.size(); index++) {
+        auto folder = index < folders.size() ? folders[index] : String{};
+        int node = getFolderNode(folder, getFolderNode);
+        this->nodes[static_cast<size_t>(node)].presets.push_back(static_cast<int>(index));
+    }
+
+    for (size_t node = static_cast<size_t>(rootNode); node < this->nodes.size(); node++) {
+        auto& current = this->nodes[node];
+
+        std::stable_sort(current.presets.begin(), current.presets.end(), [&names](int a, int b) {
+            return names[static_cast<size_t>(a)].compareNatural(names[static_cast<size_t>(b)]) < 0;
+        });
+
+        std::stable_sort(current.folders.begin(), current.folders.end(), [this](int a, int b) {
+            return this->nodes[static_cast<size_t>(a)].label.compareNatural(this->nodes[static_cast<size_t>(b)].label) < 0;
+        });
+    }
+
+    return PresetMenu::makeHandle(rootNode, 0);
+}
+
+auto PresetMenu::getLabel(int handle) const -> String {
+    int node = (handle >> PresetMenu::pageBits) - 1;
+    int page = handle & ((1 << PresetMenu::pageBits) - 1);
+    if (node < 0 || node >= static_cast<int>(this->nodes.size())) return {};
+
+    const auto& current = this->nodes[static_cast<size_t>(node)];
+    return page == 0 ? current.label : this->getPageLabel(current, page - 1);
+}
+
+auto PresetMenu::getPresetName(int id) const -> String {
+    for (const auto& source : this->sources) {
+        int index = id - source.firstID;
+        if (index >= 0 && index < static_cast<int>(source.names.size())) return source.names[static_cast<size_t>(index)];
+    }
+    return {};
+}
+
+auto PresetMenu::getEndID() const -> int {
+    int endID = 0;
+
+    for (const auto& source : this->sources) {
+        endID = std::max(endID, source.firstID + static_cast<int>(source.names.size()));
+    }
+    return endID;
+}
+
+auto PresetMenu::getPageLabel(const Node& node, int page) const -> String {
+    auto first = static_cast<size_t>(page * PresetMenu::pageSize);
+    auto last = std::min(first + PresetMenu::pageSize, node.presets.size()) - 1;
+
+    auto shorten = [](const String& name) {
+        return name.length() > 16 ? name.substring(0, 15).trimEnd() + "..." : name;
+    };
+
+    const auto& names = this->sources[node.source].names;
+    return shorten(names[static_cast<size_t>(node.presets[first])]) + " - "
+        + shorten(names[static_cast<size_t>(node.presets[last])]);
+}
+
+auto PresetMenu::addPresetItems(const Node& node, int first, int last, int currentID,
+    std::vector<NativeMenuItem>& items) const -> void {
+    const auto& source = this->sources[node.source];
+
+    for (int i = first; i < last; i++) {
+        auto index = node.presets[static_cast<size_t>(i)];
+        int id = source.firstID + index;
+        items.push_back({id, source.names[static_cast<size_t>(index)].toStdString(), id == currentID, -1});
+    }
+}
+
+auto PresetMenu::getItems(int handle, int currentID) const -> std::vector<NativeMenuItem> {
+    int node = (handle >> PresetMenu::pageBits) - 1;
+    int page = handle & ((1 << PresetMenu::pageBits) - 1);
+    if (node < 0 || node >= static_cast<int>(this->nodes.size())) return {};
+
+    const auto& current = this->nodes[static_cast<size_t>(node)];
+    int numPresets = static_cast<int>(current.presets.size());
+    std::vector<NativeMenuItem> items;
+
+    if (page > 0) {
+        int first = (page - 1) * PresetMenu::pageSize;
+        this->addPresetItems(current, first, std::min(first + PresetMenu::pageSize, numPresets), currentID, items);
+        return items;
+    }
+
+    for (auto folder : current.folders) {
+        items.push_back({0, this->nodes[static_cast<size_t>(folder)].label.toStdString(), false, PresetMenu::makeHandle(folder, 0)});
+    }
+
+    if (numPresets <= PresetMenu::pageSize) {
+        this->addPresetItems(current, 0, numPresets, currentID, items);
+        return items;
+    }
+
+    int numPages = (numPresets + PresetMenu::pageSize - 1) / PresetMenu::pageSize;
+    int maxPages = (1 << PresetMenu::pageBits) - 1;
+
+    for (int i = 0; i < std::min(numPages, maxPages); i++) {
+        items.push_back({0, this->getPageLabel(current, i).toStdString(), false, PresetMenu::makeHandle(node, i + 1)});
+    }
+
+    return items;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <JuceHeader.h>
+#include "NativeMenuBridge.h"
+
+/*
+ * Folder tree over the preset library for the preset menu. Presets are referenced by their index
+ * in the name list, so a preset's result ID is just firstID + index and selections are mapped back
+ * arithmetically. Menu levels are produced on demand from a handle that encodes the folder node and
+ * the page, and folders with more than pageSize presets are split into alphabetical pages.
+ *
+ * Each source keeps its own copy of the names (JUCE strings are shared, so this only copies pointers),
+ * so a menu that is still open keeps working after the library it was built from has changed.
+ */
+class PresetMenu {
+public:
+    static constexpr int pageSize = 100;
+
+    // folders holds each preset's subfolder path relative to the library root ("" for the root),
+    // returns the handle of the source's root folder
+    auto addSource(const String& label, const std::vector<String>& names,
+        const std::vector<String>& folders, int firstID) -> int;
+
+    // Items of a folder or page handle, currentID ticks the loaded preset
+    auto getItems(int handle, int currentID) const -> std::vector<NativeMenuItem>;
+
+    auto getLabel(int handle) const -> String;
+
+    // Name of the preset behind a result ID, empty when no source covers the ID
+    auto getPresetName(int id) const -> String;
+
+    // One past the last preset ID of every source
+    auto getEndID() const -> int;
+
+private:
+    static constexpr int pageBits = 12;
+
+    struct Source {
+        int firstID = 0;
+        std::vector<String> names;
+    };
+
+    struct Node {
+        String label;
+        size_t source = 0;
+        std::vector<int> folders;
+        std::vector<int> presets;
+    };
+
+    std::vector<Source> sources;
+    std::vector<Node> nodes;
+
+    static auto makeHandle(int node, int page) -> int;
+    auto getPageLabel(const Node& node, int page) const -> String;
+    auto addPresetItems(const Node& node, int first, int last, int currentID, std::vector<NativeMenuItem>& items) const -> void;
+};
@@ -0,0 +1,438 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cstring>
+#include <string_view>
+#include "ParameterIDs.hpp"
+
+// A fixed capacity string, long values are truncated rather than allocated. The parser's JSON
+// fallback stores the full text of a truncated field in overflow, the only case that allocates
+template <size_t capacity>
+struct PresetText {
+    std::array<char, capacity> data{};
+    size_t length = 0;
+    bool truncated = false;
+    String overflow;
+
+    auto clear() -> void {
+        this->length = 0;
+        this->truncated = false;
+        this->overflow.clear();
+    }
+
+    auto push(char c) -> void {
+        if (this->length < capacity) {
+            this->data[this->length++] = c;
+        } else {
+            this->truncated = true;
+        }
+    }
+
+    auto view() const -> std::string_view {
+        return {this->data.data(), this->length};
+    }
+
+    auto toString() const -> String {
+        if (this->truncated) return this->overflow;
+        return String::fromUTF8(this->data.data(), static_cast<int>(this->length));
+    }
+};
+
+// The parameter keys of parameters.json, resolved once so parsing only compares bytes
+class PresetSchema {
+public:
+    static constexpr size_t maxParameters = 64;
+
+    static auto instance() -> const PresetSchema& {
+        static const PresetSchema schema;
+        return schema;
+    }
+
+    auto indexOf(std::string_view key) const -> int {
+        for (size_t index = 0; index < this->numParameters; index++) {
+            if (this->keys[index] == key) return static_cast<int>(index);
+        }
+        return -1;
+    }
+
+    auto getKey(size_t index) const -> const String& {
+        return this->keyStrings[index];
+    }
+
+    size_t numParameters = 0;
+
+private:
+    std::array<std::string, maxParameters> keys;
+    std::array<String, maxParameters> keyStrings;
+
+    PresetSchema() {
+        for (const auto& key : ParameterIDs::getStringKeys()) {
+            jassert(this->numParameters < maxParameters);
+            if (this->numParameters == maxParameters) break;
+
+            this->keys[this->numParameters] = key.toStdString();
+            this->keyStrings[this->numParameters] = key;
+            this->numParameters++;
+        }
+    }
+};
+
+struct ParsedPreset {
+    static constexpr size_t textCapacity = 128;
+    static constexpr size_t valueCapacity = 32;
+
+    PresetText<textCapacity> plugin;
+    PresetText<textCapacity> version;
+    PresetText<textCapacity> name;
+    PresetText<textCapacity> author;
+    int presetFormat = 0;
+
+    std::array<PresetText<valueCapacity>, PresetSchema::maxParameters> values;
+    std::array<bool, PresetSchema::maxParameters> present{};
+    bool hasParameters = false;
+
+    auto clear() -> void {
+        for (auto* text : {&this->plugin, &this->version, &this->name, &this->author}) text->clear();
+        for (auto& value : this->values) value.clear();
+        this->present.fill(false);
+        this->presetFormat = 0;
+        this->hasParameters = false;
+    }
+
+    auto isTruncated() const -> bool {
+        for (const auto* text : {&this->plugin, &this->version, &this->name, &this->author}) {
+            if (text->truncated) return true;
+        }
+
+        for (size_t index = 0; index < this->values.size(); index++) {
+            if (this->present[index] && this->values[index].truncated) return true;
+        }
+        return false;
+    }
+};
+
+/*
+ * Single pass parser for the preset schema. Known fields are decoded straight into a ParsedPreset,
+ * everything else (modified, unknown keys, nested values) is skipped without being materialised,
+ * so parsing never touches the heap. Accepts any valid JSON, rejects malformed input. A known field
+ * longer than its capacity is read again from juce::JSON, so long names and values are never cut.
+ */
+class PresetParser {
+public:
+    static constexpr int maxDepth = 64;
+
+    static auto parse(std::string_view json, ParsedPreset& preset,
+        const PresetSchema& schema = PresetSchema::instance()) -> bool {
+        preset.clear();
+        PresetParser parser{json, schema};
+
+        parser.skipWhitespace();
+        if (!parser.parseRoot(preset)) return false;
+
+        parser.skipWhitespace();
+        if (parser.position != parser.end) return false;
+
+        return !preset.isTruncated() || PresetParser::parseTruncated(json, preset, schema);
+    }
+
+    static auto parse(const String& json, ParsedPreset& preset) -> bool {
+        auto utf8 = json.toRawUTF8();
+        return PresetParser::parse(std::string_view{utf8, std::strlen(utf8)}, preset);
+    }
+
+private:
+    const char* position;
+    const char* end;
+    const PresetSchema& schema;
+
+    // Keys are compared in place, anything longer than the longest schema key cannot match
+    using KeyText = PresetText<64>;
+
+    PresetParser(std::string_view json, const PresetSchema& schema)
+        : position(json.data()), end(json.data() + json.size()), schema(schema) {}
+
+    // Fills the overflow of every truncated field from a full parse, the fast pass already validated the input
+    static auto parseTruncated(std::string_view json, ParsedPreset& preset, const PresetSchema& schema) -> bool {
+        auto root = JSON::parse(String::fromUTF8(json.data(), static_cast<int>(json.size())));
+        if (!root.isObject()) return false;
+
+        auto restore = [](auto& text, const var& value) {
+            if (text.truncated) text.overflow = value.isString() ? value.toString() : JSON::toString(value, true);
+        };
+
+        restore(preset.plugin, root["plugin"]);
+        restore(preset.version, root["version"]);
+        restore(preset.name, root["name"]);
+        restore(preset.author, root["author"]);
+
+        const auto& parameters = root["parameters"];
+
+        for (size_t index = 0; index < schema.numParameters; index++) {
+            if (preset.present[index]) restore(preset.values[index], parameters[Identifier{schema.getKey(index)}]);
+        }
+        return true;
+    }
+
+    auto parseRoot(ParsedPreset& preset) -> bool {
+        if (!this->consume('{')) return false;
+        KeyText key;
+
+        return this->parseMembers([&]() -> bool {
+            auto field = key.view();
+
+            if (field == "plugin") return this->parseString(preset.plugin);
+            if (field == "version") return this->parseString(preset.version);
+            if (field == "name") return this->parseString(preset.name);
+            if (field == "author") return this->parseString(preset.author);
+            if (field == "presetFormat") return this->parseInteger(preset.presetFormat);
+            if (field == "parameters") return this->parseParameters(preset);
+
+            return this->skipValue(1);
+        }, key);
+    }
+
+    auto parseParameters(ParsedPreset& preset) -> bool {
+        this->skipWhitespace();
+        if (this->peek() != '{') return this->skipValue(1);
+
+        this->position++;
+        preset.hasParameters = true;
+        KeyText key;
+
+        return this->parseMembers([&]() -> bool {
+            int index = key.truncated ? -1 : this->schema.indexOf(key.view());
+            if (index < 0) return this->skipValue(2);
+
+            this->skipWhitespace();
+            auto slot = static_cast<size_t>(index);
+
+            // Older presets may store numbers, their text form goes through getValueForText just the same
+            if (this->peek() == '"') {
+                preset.present[slot] = this->parseString(preset.values[slot]);
+                return preset.present[slot];
+            }
+
+            auto start = this->position;
+            if (!this->skipValue(2)) return false;
+
+            preset.values[slot].clear();
+            for (auto c = start; c < this->position; c++) preset.values[slot].push(*c);
+            preset.present[slot] = true;
+            return true;
+        }, key);
+    }
+
+    // Iterates "key": value pairs after the opening brace, the callback parses each value
+    template <typename Callback, typename Key>
+    auto parseMembers(Callback&& parseValue, Key& key) -> bool {
+        this->skipWhitespace();
+        if (this->peek() == '}') {
+            this->position++;
+            return true;
+        }
+
+        while (true) {
+            this->skipWhitespace();
+            if (!this->parseString(key) || !this->consume(':')) return false;
+            if (!parseValue()) return false;
+
+            this->skipWhitespace();
+            if (this->peek() == ',') {
+                this->position++;
+                continue;
+            }
+            return this->consume('}');
+        }
+    }
+
+    template <typename Text>
+    auto parseString(Text& text) -> bool {
+        text.clear();
+        this->skipWhitespace();
+        if (this->peek() != '"') return false;
+        this->position++;
+
+        while (this->position < this->end) {
+            auto c = *this->position++;
+
+            if (c == '"') return true;
+            if (static_cast<unsigned char>(c) < 0x20) return false;
+
+            if (c != '\\') {
+                text.push(c);
+                continue;
+            }
+
+            if (this->position == this->end) return false;
+
+            switch (auto escape = *this->position++) {
+                case '"': case '\\': case '/': text.push(escape); break;
+                case 'b': text.push('\b'); break;
+                case 'f': text.push('\f'); break;
+                case 'n': text.push('\n'); break;
+                case 'r': text.push('\r'); break;
+                case 't': text.push('\t'); break;
+                case 'u': if (!this->parseUnicodeEscape(text)) return false; break;
+                default: return false;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename Text>
+    auto parseUnicodeEscape(Text& text) -> bool {
+        uint32 codePoint = 0;
+        if (!this->parseHex(codePoint)) return false;
+
+        // A low surrogate is only valid straight after a high one
+        if (codePoint >= 0xdc00 && codePoint < 0xe000) return false;
+
+        if (codePoint >= 0xd800 && codePoint < 0xdc00) {
+            uint32 low = 0;
+            if (this->end - this->position < 2 || this->position[0] != '\\' || this->position[1] != 'u') return false;
+            this->position += 2;
+            if (!this->parseHex(low) || low < 0xdc00 || low >= 0xe000) return false;
+            codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+        }
+
+        if (codePoint < 0x80) {
+            text.push(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            text.push(static_cast<char>(0xc0 | (codePoint >> 6)));
+            text.push(static_cast<char>(0x80 | (codePoint & 0x3f)));
+        } else if (codePoint < 0x10000) {
+            text.push(static_cast<char>(0xe0 | (codePoint >> 12)));
+            text.push(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+            text.push(static_cast<char>(0x80 | (codePoint & 0x3f)));
+        } else {
+            text.push(static_cast<char>(0xf0 | (codePoint >> 18)));
+            text.push(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f)));
+            text.push(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+            text.push(static_cast<char>(0x80 | (codePoint & 0x3f)));
+        }
+        return true;
+    }
+
+    auto parseHex(uint32& value) -> bool {
+        if (this->end - this->position < 4) return false;
+
+        for (int digit = 0; digit < 4; digit++) {
+            auto nibble = CharacterFunctions::getHexDigitValue(static_cast<juce_wchar>(*this->position++));
+            if (nibble < 0) return false;
+            value = (value << 4) | static_cast<uint32>(nibble);
+        }
+        return true;
+    }
+
+    auto parseInteger(int& value) -> bool {
+        this->skipWhitespace();
+        auto start = this->position;
+        if (!this->skipNumber()) return this->skipValue(1);
+
+        // Fractions and exponents are valid JSON but presetFormat is always a small integer
+        bool negative = *start == '-';
+        int64 result = 0;
+
+        for (auto c = start + (negative ? 1 : 0); c < this->position && *c >= '0' && *c <= '9'; c++) {
+            result = jmin(result * 10 + (*c - '0'), static_cast<int64>(std::numeric_limits<int>::max()));
+        }
+
+        value = static_cast<int>(negative ? -result : result);
+        return true;
+    }
+
+    auto skipNumber() -> bool {
+        auto start = this->position;
+        if (this->peek() == '-') this->position++;
+
+        auto digits = [this] {
+            auto first = this->position;
+            while (this->position < this->end && *this->position >= '0' && *this->position <= '9') this->position++;
+            return this->position > first;
+        };
+
+        if (!digits()) {
+            this->position = start;
+            return false;
+        }
+
+        if (this->peek() == '.') {
+            this->position++;
+            if (!digits()) return false;
+        }
+
+        if (this->peek() == 'e' || this->peek() == 'E') {
+            this->position++;
+            if (this->peek() == '+' || this->peek() == '-') this->position++;
+            if (!digits()) return false;
+        }
+
+        return true;
+    }
+
+    auto skipLiteral(std::string_view literal) -> bool {
+        if (static_cast<size_t>(this->end - this->position) < literal.size()) return false;
+        if (std::memcmp(this->position, literal.data(), literal.size()) != 0) return false;
+        this->position += literal.size();
+        return true;
+    }
+
+    auto skipValue(int depth) -> bool {
+        if (depth > PresetParser::maxDepth) return false;
+        this->skipWhitespace();
+
+        switch (this->peek()) {
+            case '"': {
+                PresetText<0> discard;
+                return this->parseString(discard);
+            }
+            case '{': {
+                this->position++;
+                PresetText<0> discard;
+                return this->parseMembers([&] { return this->skipValue(depth + 1); }, discard);
+            }
+            case '[': {
+                this->position++;
+                this->skipWhitespace();
+                if (this->peek() == ']') {
+                    this->position++;
+                    return true;
+                }
+
+                while (true) {
+                    if (!this->skipValue(depth + 1)) return false;
+                    this->skipWhitespace();
+                    if (this->peek() == ',') {
+                        this->position++;
+                        continue;
+                    }
+                    return this->consume(']');
+                }
+            }
+            case 't': return this->skipLiteral("true");
+            case 'f': return this->skipLiteral("false");
+            case 'n': return this->skipLiteral("null");
+            default: return this->skipNumber();
+        }
+    }
+
+    auto skipWhitespace() -> void {
+        while (this->position < this->end) {
+            auto c = *this->position;
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return;
+            this->position++;
+        }
+    }
+
+    auto peek() const -> char {
+        return this->position < this->end ? *this->position : '\0';
+    }
+
+    auto consume(char expected) -> bool {
+        this->skipWhitespace();
+        if (this->peek() != expected) return false;
+        this->position++;
+        return true;
+    }
+};
@@ -0,0 +1,230 @@
+#include "PresetSearchIndex.h"
+#include <algorithm>
+
+// ASCII letters and digits form words, everything else separates them. UTF-8 sequences are kept
+// as word bytes, so non-ASCII text matches but is case sensitive.
+static auto isWordByte(unsigned char c) -> bool {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+static auto toLower(unsigned char c) -> char {
+    return static_cast<char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+}
+
+static auto packTrigram(const char* bytes) -> uint32_t {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(bytes[0])) << 16)
+        | (static_cast<uint32_t>(static_cast<unsigned char>(bytes[1])) << 8)
+        | static_cast<uint32_t>(static_cast<unsigned char>(bytes[2]));
+}
+
+static auto splitWords(std::string_view source, size_t maxLength) -> std::vector<std::string> {
+    std::vector<std::string> words;
+    bool inWord = false;
+
+    for (size_t i = 0; i < std::min(source.size(), maxLength); i++) {
+        auto c = static_cast<unsigned char>(source[i]);
+
+        if (!isWordByte(c)) {
+            inWord = false;
+            continue;
+        }
+
+        if (!inWord) words.emplace_back();
+        words.back().push_back(toLower(c));
+        inWord = true;
+    }
+
+    return words;
+}
+
+auto PresetSearchIndex::clear() -> void {
+    this->text.clear();
+    this->entries.clear();
+    this->postings.clear();
+    this->trigramKeys.clear();
+    this->trigramOffsets.clear();
+    this->trigramEntries.clear();
+    this->hits.clear();
+    this->touched.clear();
+}
+
+auto PresetSearchIndex::appendPadded(std::string_view source) -> uint32_t {
+    auto start = this->text.size();
+
+    for (const auto& word : splitWords(source, source.size())) {
+        this->text.append("  ");
+        this->text.append(word);
+    }
+
+    return static_cast<uint32_t>(this->text.size() - start);
+}
+
+auto PresetSearchIndex::add(std::string_view name, std::string_view author) -> int {
+    Entry entry{};
+    entry.textOffset = static_cast<uint32_t>(this->text.size());
+    entry.nameLength = this->appendPadded(name);
+    entry.authorLength = this->appendPadded(author);
+
+    auto number = static_cast<uint32_t>(this->entries.size());
+    this->entries.push_back(entry);
+
+    this->addPostings(entry.textOffset, entry.nameLength, 0, number);
+    this->addPostings(entry.textOffset + entry.nameLength, entry.authorLength, PresetSearchIndex::authorKey, number);
+
+    return static_cast<int>(number);
+}
+
+auto PresetSearchIndex::addPostings(uint32_t offset, uint32_t length, uint32_t keySpace, uint32_t number) -> void {
+    const auto* region = this->text.data() + offset;
+
+    for (uint32_t i = 0; i + 3 <= length; i++) {
+        auto key = packTrigram(region + i) | keySpace;
+        this->postings.push_back((static_cast<uint64_t>(key) << 32) | number);
+    }
+}
+
+auto PresetSearchIndex::finalise() -> void {
+    std::sort(this->postings.begin(), this->postings.end());
+    this->postings.erase(std::unique(this->postings.begin(), this->postings.end()), this->postings.end());
+
+    this->trigramKeys.clear();
+    this->trigramOffsets.clear();
+    this->trigramEntries.clear();
+    this->trigramEntries.reserve(this->postings.size());
+
+    for (auto posting : this->postings) {
+        auto trigram = static_cast<uint32_t>(posting >> 32);
+
+        if (this->trigramKeys.empty() || this->trigramKeys.back() != trigram) {
+            this->trigramKeys.push_back(trigram);
+            this->trigramOffsets.push_back(static_cast<uint32_t>(this->trigramEntries.size()));
+        }
+        this->trigramEntries.push_back(static_cast<uint32_t>(posting & 0xffffffffu));
+    }
+
+    this->trigramOffsets.push_back(static_cast<uint32_t>(this->trigramEntries.size()));
+
+    this->postings.clear();
+    this->postings.shrink_to_fit();
+    this->hits.assign(this->entries.size(), Hits{});
+    this->touched.reserve(this->entries.size());
+}
+
+auto PresetSearchIndex::getNumEntries() const -> int {
+    return static_cast<int>(this->entries.size());
+}
+
+auto PresetSearchIndex::getPostings(uint32_t trigram) const -> std::pair<const uint32_t*, const uint32_t*> {
+    auto it = std::lower_bound(this->trigramKeys.begin(), this->trigramKeys.end(), trigram);
+    if (it == this->trigramKeys.end() || *it != trigram) return {nullptr, nullptr};
+
+    auto key = static_cast<size_t>(it - this->trigramKeys.begin());
+    const auto* base = this->trigramEntries.data();
+    return {base + this->trigramOffsets[key], base + this->trigramOffsets[key + 1]};
+}
+
+auto PresetSearchIndex::search(std::string_view query, int limit) -> std::vector<Result> {
+    auto words = splitWords(query, PresetSearchIndex::maxQueryLength);
+    if (words.empty() || limit <= 0 || this->entries.empty()) return {};
+
+    std::string padded;
+    std::vector<uint32_t> longTrigrams;
+    std::vector<uint32_t> startTrigrams;
+    std::vector<uint32_t> shortTrigrams;
+
+    for (const auto& word : words) {
+        padded.append("  ").append(word);
+
+        // "  a" for one character, otherwise " ab", only found where a word starts
+        auto start = "  " + word.substr(0, 2);
+        auto startTrigram = packTrigram(start.data() + start.size() - 3);
+        startTrigrams.push_back(startTrigram);
+
+        if (word.size() < 3) {
+            shortTrigrams.push_back(startTrigram);
+            continue;
+        }
+
+        for (size_t i = 0; i + 3 <= word.size(); i++) longTrigrams.push_back(packTrigram(word.data() + i));
+    }
+
+    for (auto* trigrams : {&longTrigrams, &startTrigrams, &shortTrigrams}) {
+        std::sort(trigrams->begin(), trigrams->end());
+        trigrams->erase(std::unique(trigrams->begin(), trigrams->end()), trigrams->end());
+    }
+
+    this->touched.clear();
+
+    auto visit = [this](uint32_t key, auto&& count) {
+        auto [begin, end] = this->getPostings(key);
+
+        for (auto* entry = begin; entry != end; entry++) {
+            auto& entryHits = this->hits[*entry];
+            if (entryHits.name == 0 && entryHits.nameStarts == 0 && entryHits.author == 0 && entryHits.authorStarts == 0) {
+                this->touched.push_back(*entry);
+            }
+            count(entryHits);
+        }
+    };
+
+    for (auto trigram : longTrigrams) {
+        visit(trigram, [](Hits& entryHits) { entryHits.name++; });
+        visit(trigram | PresetSearchIndex::authorKey, [](Hits& entryHits) { entryHits.author++; });
+    }
+
+    for (auto trigram : startTrigrams) {
+        auto it = std::lower_bound(shortTrigrams.begin(), shortTrigrams.end(), trigram);
+        uint32_t shortBit = it != shortTrigrams.end() && *it == trigram ? 1u << (it - shortTrigrams.begin()) : 0u;
+
+        visit(trigram, [shortBit](Hits& entryHits) {
+            entryHits.nameStarts++;
+            entryHits.shortWords |= shortBit;
+        });
+        visit(trigram | PresetSearchIndex::authorKey, [shortBit](Hits& entryHits) {
+            entryHits.authorStarts++;
+            entryHits.shortWords |= shortBit;
+        });
+    }
+
+    // Short words must all match, long words tolerate typos by needing half of their trigrams
+    auto threshold = static_cast<int>((longTrigrams.size() + 1) / 2);
+    auto allShortWords = static_cast<uint32_t>((uint64_t{1} << shortTrigrams.size()) - 1);
+    auto numLong = static_cast<int>(longTrigrams.size());
+    auto numStarts = static_cast<int>(startTrigrams.size());
+
+    std::vector<Result> results;
+
+    for (auto number : this->touched) {
+        auto entryHits = this->hits[number];
+        this->hits[number] = {};
+
+        if (entryHits.shortWords != allShortWords || entryHits.name + entryHits.author < threshold) continue;
+
+        int score = 4 * entryHits.name + 6 * entryHits.nameStarts + 2 * entryHits.author + 3 * entryHits.authorStarts;
+
+        // Only a name holding every query trigram can equal or start with the query
+        if (entryHits.name == numLong && entryHits.nameStarts == numStarts) {
+            const auto& entry = this->entries[number];
+            auto name = std::string_view{this->text}.substr(entry.textOffset, entry.nameLength);
+
+            if (name == padded) score += 100;
+            else if (name.substr(0, padded.size()) == padded) score += 30;
+        }
+
+        results.push_back({static_cast<int>(number), score});
+    }
+
+    auto ranked = [this](const Result& a, const Result& b) {
+        if (a.score != b.score) return a.score > b.score;
+
+        auto lengthA = this->entries[static_cast<size_t>(a.entry)].nameLength;
+        auto lengthB = this->entries[static_cast<size_t>(b.entry)].nameLength;
+        return lengthA != lengthB ? lengthA < lengthB : a.entry < b.entry;
+    };
+
+    auto count = std::min(results.size(), static_cast<size_t>(limit));
+    std::partial_sort(results.begin(), results.begin() + static_cast<std::ptrdiff_t>(count), results.end(), ranked);
+    results.resize(count);
+
+    return results;
+}
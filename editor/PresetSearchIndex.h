@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+ * Trigram index over preset names and authors. Text is lowercased and every word is prefixed with
+ * two spaces, so "  d" and " du" are word-start trigrams and one or two character queries become
+ * word prefix lookups on the same posting lists. Author trigrams live in their own key space so a
+ * query learns where it matched from the postings alone, without rescanning any text.
+ *
+ * Longer query words are matched fuzzily: a preset is a candidate when it shares at least half of
+ * their trigrams, and candidates are ranked by name over author matches and word starts over
+ * substrings, with exact and prefix name matches first.
+ */
+class PresetSearchIndex {
+public:
+    struct Result {
+        int entry;
+        int score;
+    };
+
+    auto clear() -> void;
+    auto add(std::string_view name, std::string_view author) -> int;
+    auto finalise() -> void;
+
+    auto getNumEntries() const -> int;
+
+    // Ranked best first, results are entry numbers in the order they were added
+    auto search(std::string_view query, int limit) -> std::vector<Result>;
+
+    static constexpr size_t maxQueryLength = 64;
+
+private:
+    struct Entry {
+        uint32_t textOffset;
+        uint32_t nameLength;
+        uint32_t authorLength;
+    };
+
+    std::string text;
+    std::vector<Entry> entries;
+
+    std::vector<uint64_t> postings;
+    std::vector<uint32_t> trigramKeys;
+    std::vector<uint32_t> trigramOffsets;
+    std::vector<uint32_t> trigramEntries;
+
+    // Per entry counts for the current query, sized once per build so searching does not allocate per candidate
+    struct Hits {
+        uint8_t name;
+        uint8_t nameStarts;
+        uint8_t author;
+        uint8_t authorStarts;
+        uint32_t shortWords;
+    };
+
+    std::vector<Hits> hits;
+    std::vector<uint32_t> touched;
+
+    static constexpr uint32_t authorKey = 1u << 24;
+
+    auto appendPadded(std::string_view source) -> uint32_t;
+    auto addPostings(uint32_t offset, uint32_t length, uint32_t keySpace, uint32_t number) -> void;
+    auto getPostings(uint32_t trigram) const -> std::pair<const uint32_t*, const uint32_t*>;
+};
@@ -1,8 +1,19 @@
 #pragma once
 #include <JuceHeader.h>
+#include "Trace.hpp"
+
+// Only the benchmark app counts settings file accesses
+#ifndef GAIN_BOOSTER_BENCHMARK
+    #define GAIN_BOOSTER_BENCHMARK 0
+#endif
 
 class Settings {
 public:
+    #if GAIN_BOOSTER_BENCHMARK
+        // Counts every read or write of settings.json, scan-only instantiation should leave it untouched
+        static inline std::atomic<int> fileAccesses{0};
+    #endif
+
     static auto getSettingsFile() -> File {
         return File::getSpecialLocation(File::userApplicationDataDirectory)
             .getChildFile(JucePlugin_Manufacturer)
@@ -11,6 +22,10 @@ public:
     }
 
     static auto setSettingKey(const String& key, const var& value) -> void {
+        TRACE_SCOPE("Settings::setSettingKey");
+        #if GAIN_BOOSTER_BENCHMARK
+            Settings::fileAccesses.fetch_add(1, std::memory_order_relaxed);
+        #endif
         auto file = getSettingsFile();
         var json;
     
@@ -25,6 +40,10 @@ public:
     }
 
     static auto getSettingKey(const String& key, const var& defaultValue) -> var {
+        TRACE_SCOPE("Settings::getSettingKey");
+        #if GAIN_BOOSTER_BENCHMARK
+            Settings::fileAccesses.fetch_add(1, std::memory_order_relaxed);
+        #endif
         auto file = getSettingsFile();
     
         if (!file.existsAsFile()) return defaultValue;
@@ -0,0 +1,101 @@
+#include "WebviewPool.h"
+#include "Trace.hpp"
+
+#if JUCE_WEB_BROWSER
+
+struct WebviewPool::Lease::Entry {
+    std::unique_ptr<WebBrowserComponent> webview;
+    NativeFunctions functions;
+    int generation = 0;
+};
+
+WebviewPool::Lease::Lease(std::unique_ptr<Entry> entry) : entry(std::move(entry)) {}
+
+WebviewPool::Lease::~Lease() {
+    this->pool->release(std::move(this->entry));
+}
+
+auto WebviewPool::Lease::getWebview() -> WebBrowserComponent& {
+    return *this->entry->webview;
+}
+
+auto WebviewPool::Lease::getGeneration() const -> int {
+    return this->entry->generation;
+}
+
+// Out of line so the idle entries are destroyed where Entry is complete
+WebviewPool::~WebviewPool() = default;
+
+auto WebviewPool::lease(ResourceProvider resources, NativeFunctions functions) -> std::unique_ptr<Lease> {
+    JUCE_ASSERT_MESSAGE_THREAD
+    TRACE_SCOPE("WebviewPool::lease");
+
+    if (!this->resources) {
+        this->resources = std::move(resources);
+        for (const auto& [name, function] : functions) this->functionNames.add(name);
+    }
+
+    std::unique_ptr<Lease::Entry> entry;
+
+    if (!this->idle.empty()) {
+        entry = std::move(this->idle.back());
+        this->idle.pop_back();
+        entry->generation++;
+    } else {
+        entry = this->createEntry();
+    }
+
+    entry->functions = std::move(functions);
+    if (this->idle.empty()) this->scheduleWarmUp();
+
+    return std::unique_ptr<Lease>{new Lease{std::move(entry)}};
+}
+
+auto WebviewPool::createEntry() -> std::unique_ptr<Lease::Entry> {
+    TRACE_SCOPE("WebviewPool::createEntry");
+    auto entry = std::make_unique<Lease::Entry>();
+    auto* target = entry.get();
+
+    auto options = WebBrowserComponent::Options{}
+        .withBackend(WebBrowserComponent::Options::Backend::webview2)
+        .withWinWebView2Options(WebBrowserComponent::Options::WinWebView2{}
+        .withUserDataFolder(File::getSpecialLocation(File::tempDirectory)))
+        .withResourceProvider(this->resources)
+        .withNativeIntegrationEnabled()
+        .withKeepPageLoadedWhenBrowserIsHidden();
+
+    for (const auto& name : this->functionNames) {
+        options = options.withNativeFunction(name, [target, name](const Array<var>& args,
+            WebBrowserComponent::NativeFunctionCompletion completion) {
+            auto it = target->functions.find(name);
+            if (it == target->functions.end()) return completion(var{});
+            it->second(args, std::move(completion));
+        });
+    }
+
+    entry->webview = std::make_unique<WebBrowserComponent>(options);
+    entry->webview->goToURL(entry->webview->getResourceProviderRoot());
+    return entry;
+}
+
+auto WebviewPool::release(std::unique_ptr<Lease::Entry> entry) -> void {
+    entry->functions.clear();
+
+    if (auto* parent = entry->webview->getParentComponent()) {
+        parent->removeChildComponent(entry->webview.get());
+    }
+
+    if (static_cast<int>(this->idle.size()) < WebviewPool::maxIdle) {
+        this->idle.push_back(std::move(entry));
+    }
+}
+
+auto WebviewPool::scheduleWarmUp() -> void {
+    // Deferred so the spare page loads after the editor that triggered it is already on screen
+    Timer::callAfterDelay(WebviewPool::warmUpDelayMs, [pool = WeakReference<WebviewPool>{this}] {
+        if (pool == nullptr || !pool->idle.empty()) return;
+        pool->idle.push_back(pool->createEntry());
+    });
+}
+
+#endif
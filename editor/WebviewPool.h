@@ -0,0 +1,64 @@
+#pragma once
+#include <JuceHeader.h>
+#include <map>
+
+#if JUCE_WEB_BROWSER
+
+/*
+ * Process-wide pool of loaded webviews shared by every editor. An editor leases a webview for its
+ * lifetime and returns it when it closes, so reopening any instance's window skips creating the
+ * browser and loading the page. After a lease is taken one spare is warmed up on a short delay,
+ * keeping the next first open fast too.
+ *
+ * Native functions are registered once per webview and forward to the current lease's functions,
+ * an idle webview answers every call with an empty result. Each lease gets a new generation, sent
+ * to the page with the editorAttached event, so the page can tell calls queued for the previous
+ * editor from its own.
+ */
+class WebviewPool {
+public:
+    using NativeFunctions = std::map<String, WebBrowserComponent::NativeFunction>;
+    using ResourceProvider = std::function<std::optional<WebBrowserComponent::Resource>(const String& url)>;
+
+    static constexpr int maxIdle = 2;
+    static constexpr int warmUpDelayMs = 1000;
+
+    class Lease {
+    public:
+        ~Lease();
+
+        auto getWebview() -> WebBrowserComponent&;
+        auto getGeneration() const -> int;
+
+    private:
+        friend class WebviewPool;
+        struct Entry;
+
+        explicit Lease(std::unique_ptr<Entry> entry);
+
+        SharedResourcePointer<WebviewPool> pool;
+        std::unique_ptr<Entry> entry;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Lease)
+    };
+
+    WebviewPool() = default;
+    ~WebviewPool();
+
+    // Every editor passes the same resource provider and function names, the first call fixes them
+    auto lease(ResourceProvider resources, NativeFunctions functions) -> std::unique_ptr<Lease>;
+
+private:
+    std::vector<std::unique_ptr<Lease::Entry>> idle;
+    ResourceProvider resources;
+    StringArray functionNames;
+
+    auto createEntry() -> std::unique_ptr<Lease::Entry>;
+    auto release(std::unique_ptr<Lease::Entry> entry) -> void;
+    auto scheduleWarmUp() -> void;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(WebviewPool)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WebviewPool)
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include <JuceHeader.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include "PresetBank.h"
+
+/*
+ * Writes a small bank and reads it back, then damages copies of the file one field at a time.
+ * Every damaged copy must be refused by PresetBank::open, since the accessors trust what validate
+ * accepted and read the mapping without further bounds checks.
+ */
+
+static int failures = 0;
+
+static auto expect(bool passed, const char* description) -> void {
+    if (!passed) failures++;
+    std::printf("%-52s %s\n", description, passed ? "ok" : "FAILED");
+}
+
+// Values are stored as written, so they compare exactly
+static auto same(float value, float expected) -> bool {
+    return !std::isnan(value) && !std::islessgreater(value, expected);
+}
+
+static auto writeUInt32(MemoryBlock& data, size_t offset, uint32 value) -> void {
+    std::memcpy(static_cast<char*>(data.getData()) + offset, &value, sizeof(value));
+}
+
+static auto readHeader(const MemoryBlock& data) -> PresetBank::Header {
+    PresetBank::Header header;
+    std::memcpy(&header, data.getData(), sizeof(header));
+    return header;
+}
+
+// Writes the bytes to a file of their own and reports whether the bank opens
+static auto opens(const MemoryBlock& data) -> bool {
+    TemporaryFile temporary{PresetBank::fileExtension};
+    if (!temporary.getFile().replaceWithData(data.getData(), data.getSize())) return false;
+    return PresetBank::open(temporary.getFile()) != nullptr;
+}
+
+static auto testRoundTrip(const File& file) -> void {
+    StringArray keys{"gain", "boost", "pan"};
+    std::vector<PresetBank::Preset> presets{
+        {"Zeta Pump", "Moebytes", "", {0.25f, 0.5f, 0.75f}},
+        {"Alpha Gate", "Guest Artist", "Gates/Fast", {1.0f, 0.0f, 0.5f}},
+        {String::fromUTF8("M\xc3\xa9tro"), "", "Tempo", {0.125f}}
+    };
+
+    expect(PresetBank::write(file, keys, presets), "bank written");
+
+    auto bank = PresetBank::open(file);
+    expect(bank != nullptr, "bank opened");
+    if (bank == nullptr) return;
+
+    expect(bank->getNumPresets() == 3 && bank->getNumParameters() == 3, "preset and parameter counts");
+    expect(bank->getParameterKey(0) == "gain" && bank->getParameterKey(2) == "pan", "parameter keys");
+    expect(bank->getName(0) == "Alpha Gate" && bank->getName(1) == "M\xc3\xa9tro" && bank->getName(2) == "Zeta Pump", "index sorted by name bytes");
+    expect(bank->getAuthor(0) == "Guest Artist" && bank->getAuthor(1).empty(), "authors");
+    expect(bank->getFolder(0) == "Gates/Fast" && bank->getFolder(2).empty(), "folders");
+    expect(same(bank->getValue(2, 0), 0.25f) && same(bank->getValue(2, 2), 0.75f), "values follow their preset");
+    expect(same(bank->getValue(1, 0), 0.125f) && std::isnan(bank->getValue(1, 1)), "missing values stored as NaN");
+    expect(bank->findPreset("Zeta Pump") == 2 && bank->findPreset("Zeta") == -1, "findPreset");
+}
+
+static auto testDamaged(const File& file) -> void {
+    MemoryBlock original;
+    if (!file.loadFileAsData(original)) {
+        expect(false, "bank read back");
+        return;
+    }
+
+    auto header = readHeader(original);
+    expect(opens(original), "unmodified copy opens");
+
+    auto damaged = [&original](auto&& modify) {
+        MemoryBlock data{original};
+        modify(data);
+        return !opens(data);
+    };
+
+    expect(damaged([](MemoryBlock& data) { data.setSize(0); }), "empty file rejected");
+    expect(damaged([](MemoryBlock& data) { data.setSize(sizeof(PresetBank::Header) - 1); }), "truncated header rejected");
+    expect(damaged([](MemoryBlock& data) { data.setSize(data.getSize() - 1); }), "truncated string table rejected");
+    expect(damaged([&header](MemoryBlock& data) { data.setSize(header.recordsOffset + 4); }), "truncated records rejected");
+
+    expect(damaged([](MemoryBlock& data) { static_cast<char*>(data.getData())[0] = 'X'; }), "bad magic rejected");
+    expect(damaged([](MemoryBlock& data) {
+        writeUInt32(data, offsetof(PresetBank::Header, version), PresetBank::formatVersion + 1);
+    }), "unknown version rejected");
+
+    expect(damaged([](MemoryBlock& data) {
+        writeUInt32(data, offsetof(PresetBank::Header, keysOffset), static_cast<uint32>(data.getSize()));
+    }), "keys offset past the end rejected");
+    expect(damaged([](MemoryBlock& data) {
+        writeUInt32(data, offsetof(PresetBank::Header, indexOffset), 0xffffffff);
+    }), "index offset past the end rejected");
+    expect(damaged([](MemoryBlock& data) {
+        writeUInt32(data, offsetof(PresetBank::Header, recordsOffset), static_cast<uint32>(data.getSize()) - 4);
+    }), "records overrunning the end rejected");
+    expect(damaged([&header](MemoryBlock& data) {
+        writeUInt32(data, offsetof(PresetBank::Header, stringsSize), header.stringsSize + 1);
+    }), "string table overrunning the end rejected");
+    expect(damaged([](MemoryBlock& data) {
+        writeUInt32(data, offsetof(PresetBank::Header, numPresets), 0x40000000);
+    }), "oversized preset count rejected");
+
+    auto keyEntry = static_cast<size_t>(header.keysOffset);
+    auto indexEntry = static_cast<size_t>(header.indexOffset);
+
+    expect(damaged([&](MemoryBlock& data) {
+        writeUInt32(data, keyEntry + offsetof(PresetBank::KeyEntry, length), header.stringsSize + 1);
+    }), "key string past the table rejected");
+    expect(damaged([&](MemoryBlock& data) {
+        writeUInt32(data, indexEntry + offsetof(PresetBank::IndexEntry, nameOffset), header.stringsSize);
+    }), "name string past the table rejected");
+    expect(damaged([&](MemoryBlock& data) {
+        writeUInt32(data, indexEntry + offsetof(PresetBank::IndexEntry, authorOffset), 0xffffffff);
+    }), "author offset overflow rejected");
+    expect(damaged([&](MemoryBlock& data) {
+        writeUInt32(data, indexEntry + sizeof(PresetBank::IndexEntry) + offsetof(PresetBank::IndexEntry, folderLength), 0xffffffff);
+    }), "folder length overflow rejected");
+}
+
+auto main() -> int {
+    TemporaryFile temporary{PresetBank::fileExtension};
+
+    testRoundTrip(temporary.getFile());
+    testDamaged(temporary.getFile());
+
+    return failures == 0 ? 0 : 1;
+}
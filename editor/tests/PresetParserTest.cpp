@@ -0,0 +1,119 @@
+#include <JuceHeader.h>
+#include <cstdio>
+#include <string>
+#include "PresetParser.hpp"
+
+/*
+ * Feeds PresetParser valid and malformed documents. Malformed input must be rejected as a whole,
+ * escapes must decode to UTF-8, and a field longer than its capacity must come back in full from
+ * the juce::JSON fallback.
+ */
+
+static int failures = 0;
+
+static auto expect(bool passed, const char* description) -> void {
+    if (!passed) failures++;
+    std::printf("%-52s %s\n", description, passed ? "ok" : "FAILED");
+}
+
+static auto parses(std::string_view json) -> bool {
+    ParsedPreset preset;
+    return PresetParser::parse(json, preset);
+}
+
+static auto valueOf(const ParsedPreset& preset, std::string_view key) -> String {
+    auto index = PresetSchema::instance().indexOf(key);
+    if (index < 0 || !preset.present[static_cast<size_t>(index)]) return "<missing>";
+    return preset.values[static_cast<size_t>(index)].toString();
+}
+
+static auto testFields() -> void {
+    ParsedPreset preset;
+    bool parsed = PresetParser::parse(std::string_view{R"({
+        "plugin": "Gain Booster", "version": "0.0.6", "name": "Pump", "author": "Moebytes",
+        "modified": {"nested": [1, 2.5e3, null, true, false]}, "presetFormat": 1,
+        "parameters": {"gain": "50%", "unknown": [1], "boost": "6.0dB"}
+    })"}, preset);
+
+    expect(parsed, "valid preset");
+    expect(preset.name.toString() == "Pump" && preset.author.toString() == "Moebytes", "name and author");
+    expect(preset.presetFormat == 1, "presetFormat");
+    expect(preset.hasParameters, "parameters object");
+    expect(valueOf(preset, "gain") == "50%" && valueOf(preset, "boost") == "6.0dB", "string parameter values");
+    expect(valueOf(preset, "pan") == "<missing>", "absent parameter not present");
+}
+
+static auto testMalformed() -> void {
+    expect(!parses(""), "empty input rejected");
+    expect(!parses("[]"), "non-object root rejected");
+    expect(!parses(R"({"name": "Pump")"), "missing closing brace rejected");
+    expect(!parses(R"({"name": "Pump",})"), "trailing comma rejected");
+    expect(!parses(R"({"name" "Pump"})"), "missing colon rejected");
+    expect(!parses(R"({"name": "Pump})"), "unterminated string rejected");
+    expect(!parses("{\"name\": \"Pu\nmp\"}"), "raw control character rejected");
+    expect(!parses(R"({"name": "\q"})"), "unknown escape rejected");
+    expect(!parses(R"({"modified": tru})"), "truncated literal rejected");
+    expect(!parses(R"({"presetFormat": 1.})"), "truncated number rejected");
+    expect(!parses(R"({"parameters": {"gain": "50%")"), "unclosed parameters rejected");
+    expect(!parses(R"({"name": "Pump"} x)"), "trailing garbage rejected");
+    expect(!parses(R"({"name": "Pump"}{})"), "second document rejected");
+    expect(parses("{\"name\": \"Pump\"}\r\n\t "), "trailing whitespace accepted");
+}
+
+static auto testEscapes() -> void {
+    ParsedPreset preset;
+    bool parsed = PresetParser::parse(std::string_view{R"({"name": "\ud83c\udfb5 \u00e9\u20ac \"a\/b\"\n"})"}, preset);
+    expect(parsed && preset.name.view() == "\xf0\x9f\x8e\xb5 \xc3\xa9\xe2\x82\xac \"a/b\"\n", "surrogate pair and escapes decode to UTF-8");
+
+    expect(!parses(R"({"name": "\ud83c"})"), "lone high surrogate rejected");
+    expect(!parses(R"({"name": "\ud83cx"})"), "high surrogate without escape rejected");
+    expect(!parses(R"({"name": "\ud83c\u0041"})"), "high surrogate with non-low pair rejected");
+    expect(!parses(R"({"name": "\udfb5"})"), "lone low surrogate rejected");
+    expect(!parses(R"({"name": "\u12g4"})"), "invalid hex digit rejected");
+    expect(!parses(R"({"name": "\u12"})"), "short escape rejected");
+}
+
+static auto testTruncatedFallback() -> void {
+    std::string longName(ParsedPreset::textCapacity + 40, 'x');
+    std::string longRate(ParsedPreset::valueCapacity + 8, 'r');
+    auto json = R"({"name": ")" + longName + R"(é", "parameters": {"gainLFORate": ")" + longRate + R"("}})";
+
+    ParsedPreset preset;
+    bool parsed = PresetParser::parse(std::string_view{json}, preset);
+
+    expect(parsed && preset.name.truncated, "long name parsed through the fallback");
+    expect(preset.name.toString() == String{longName.c_str()} + String::fromUTF8("\xc3\xa9"), "long name restored in full");
+    expect(valueOf(preset, "gainLFORate") == String{longRate.c_str()}, "long parameter value restored in full");
+}
+
+static auto testNonStringValues() -> void {
+    ParsedPreset preset;
+    bool parsed = PresetParser::parse(std::string_view{R"({"parameters": {"gain": 0.5, "boost": -1.25e1, "panLFOAmount": true, "pan": false}})"}, preset);
+
+    expect(parsed, "numeric and boolean values accepted");
+    expect(valueOf(preset, "gain") == "0.5" && valueOf(preset, "boost") == "-1.25e1", "numbers kept as their text");
+    expect(valueOf(preset, "panLFOAmount") == "true" && valueOf(preset, "pan") == "false", "booleans kept as their text");
+    expect(!parses(R"({"parameters": {"gain": 0.5.5}})"), "malformed numeric value rejected");
+}
+
+static auto testDepthLimit() -> void {
+    auto nested = [](int depth) {
+        return R"({"modified": )" + std::string(static_cast<size_t>(depth), '[') + std::string(static_cast<size_t>(depth), ']') + "}";
+    };
+
+    expect(parses(nested(PresetParser::maxDepth)), "nesting at the depth limit accepted");
+    expect(!parses(nested(PresetParser::maxDepth + 1)), "nesting past the depth limit rejected");
+    expect(!parses(R"({"parameters": {"unknown": )" + std::string(static_cast<size_t>(PresetParser::maxDepth), '[') + std::string(static_cast<size_t>(PresetParser::maxDepth), ']') + "}}"),
+        "parameters count towards the depth limit");
+}
+
+auto main() -> int {
+    testFields();
+    testMalformed();
+    testEscapes();
+    testTruncatedFallback();
+    testNonStringValues();
+    testDepthLimit();
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "PresetSearchIndex.h"
+
+/*
+ * Searches a small library and checks which entries come back and in what order: exact name
+ * matches before name prefixes, names before authors, shorter names first on equal scores, and
+ * misspelt words still found through their shared trigrams.
+ */
+
+static int failures = 0;
+
+static auto search(PresetSearchIndex& index, std::string_view query, int limit = 20) -> std::vector<int> {
+    std::vector<int> entries;
+    for (const auto& result : index.search(query, limit)) entries.push_back(result.entry);
+    return entries;
+}
+
+static auto expect(PresetSearchIndex& index, std::string_view query, const std::vector<int>& expected, int limit = 20) -> void {
+    auto entries = search(index, query, limit);
+    bool passed = entries == expected;
+    if (!passed) failures++;
+
+    std::string found;
+    for (auto entry : entries) found += std::to_string(entry) + " ";
+
+    std::printf("%-16s %-24s %s\n", std::string{query}.c_str(), found.c_str(), passed ? "ok" : "FAILED");
+}
+
+auto main() -> int {
+    PresetSearchIndex index;
+
+    index.add("Dubstep Wobble", "Moebytes");   // 0
+    index.add("Dub", "Factory");               // 1
+    index.add("Dubstep", "Factory");           // 2
+    index.add("Soft Pad", "Dub Collective");   // 3
+    index.add("Wobble Bass", "Moebytes");      // 4
+    index.add("Sidechain Pump", "Studio");     // 5
+    index.finalise();
+
+    // Exact name, then name prefixes shortest first, then the author match
+    expect(index, "dub", {1, 2, 0, 3});
+    expect(index, "DUBSTEP", {2, 0});
+
+    // One and two letters are word prefix lookups
+    expect(index, "d", {1, 2, 0, 3});
+    expect(index, "wo", {4, 0});
+    expect(index, "s", {5, 3});
+    expect(index, "d", {1, 2}, 2);
+
+    // Matches only in the author
+    expect(index, "moebytes", {4, 0});
+    expect(index, "studio", {5});
+
+    // Typos keep at least half of the trigrams
+    expect(index, "dubstap", {2, 0});
+    expect(index, "wobbel", {4, 0});
+    expect(index, "sidechian", {5});
+
+    // Every short word must match, long words are fuzzy
+    expect(index, "wob ba", {4});
+    expect(index, "pump side", {5});
+
+    expect(index, "", {});
+    expect(index, "zzz", {});
+    expect(index, "dub", {}, 0);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+#include <JuceHeader.h>
+#include "Processor.h"
+#include "PCMStream.hpp"
+#include "SyntheticPlayHead.hpp"
+
+#if JUCE_WINDOWS
+    #include <fcntl.h>
+    #include <io.h>
+#endif
+
+static auto parseFormat(const String& name) -> std::optional<PCMFormat> {
+    if (name == "f32") return PCMFormat::float32;
+    if (name == "s16") return PCMFormat::int16;
+    if (name == "s24") return PCMFormat::int24;
+    return std::nullopt;
+}
+
+static auto parseTimeSignature(const String& text) -> AudioPlayHead::TimeSignature {
+    auto numerator = text.upToFirstOccurrenceOf("/", false, false).getIntValue();
+    auto denominator = text.fromFirstOccurrenceOf("/", false, false).getIntValue();
+    if (numerator <= 0 || denominator <= 0) ConsoleApplication::fail("Invalid time signature: " + text);
+    return {numerator, denominator};
+}
+
+static auto getOption(const ArgumentList& args, const String& option, const String& defaultValue) -> String {
+    auto value = args.getValueForOption(option);
+    return value.isEmpty() ? defaultValue : value;
+}
+
+static auto loadSettings(Processor& processor, const ArgumentList& args) -> void {
+    if (args.containsOption("--preset")) {
+        auto file = args.getExistingFileForOption("--preset");
+        auto json = file.loadFileAsString();
+
+        if (JSON::fromString(json).getProperty("parameters", {}).getDynamicObject() == nullptr) {
+            ConsoleApplication::fail("Not a preset file: " + file.getFullPathName());
+        }
+        processor.presetManager.loadPreset(json);
+    }
+
+    if (args.containsOption("--factory")) {
+        auto name = args.getValueForOption("--factory");
+        processor.presetManager.ensureFactoryPresets();
+
+        auto preset = processor.presetManager.factoryPresets.find(name);
+        if (preset == processor.presetManager.factoryPresets.end()) ConsoleApplication::fail("No factory preset named " + name);
+        processor.presetManager.loadPreset(preset->second);
+    }
+
+    if (args.containsOption("--state")) {
+        MemoryBlock state;
+        if (!args.getExistingFileForOption("--state").loadFileAsData(state)) ConsoleApplication::fail("Could not read the state file");
+        processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    }
+}
+
+// Output failures (usually a closed pipe) end the process without unwinding, the reader may be blocked on stdin
+[[noreturn]] static auto exitOnOutputError() -> void {
+    std::fputs("Gain Booster Filter: could not write to stdout\n", stderr);
+    std::fflush(stderr);
+    std::_Exit(1);
+}
+
+static auto runFilter(const ArgumentList& args) -> void {
+    #if JUCE_WINDOWS
+        _setmode(_fileno(stdin), _O_BINARY);
+        _setmode(_fileno(stdout), _O_BINARY);
+    #endif
+
+    StreamFormat format;
+    auto formatOption = parseFormat(getOption(args, "--format", "f32"));
+    if (!formatOption.has_value()) ConsoleApplication::fail("Unknown format, expected f32, s16 or s24");
+
+    format.format = *formatOption;
+    format.sampleRate = getOption(args, "--rate", "48000").getDoubleValue();
+
+    int blockFrames = jmax(1, getOption(args, "--block-size", "512").getIntValue());
+    double bpm = getOption(args, "--bpm", "120").getDoubleValue();
+    auto timeSignature = parseTimeSignature(getOption(args, "--time-signature", "4/4"));
+    double startPPQ = getOption(args, "--start-ppq", "0").getDoubleValue();
+    auto input = getOption(args, "--input", "auto");
+
+    if (bpm <= 0.0) ConsoleApplication::fail("--bpm must be positive");
+
+    // Raw streams can start with anything, so the sniffed bytes are handed to the reader when they are audio
+    MemoryBlock prefix;
+
+    if (input != "raw") {
+        char magic[4];
+        auto count = std::fread(magic, 1, sizeof(magic), stdin);
+
+        if (count == sizeof(magic) && std::memcmp(magic, "RIFF", 4) == 0) {
+            auto error = WavHeader::read(stdin, format);
+            if (error.isNotEmpty()) ConsoleApplication::fail("Invalid WAV input: " + error);
+            format.wav = true;
+        } else if (input == "wav") {
+            ConsoleApplication::fail("Input is not a RIFF/WAVE stream");
+        } else {
+            prefix.append(magic, count);
+        }
+    }
+
+    if (format.sampleRate <= 0.0) ConsoleApplication::fail("--rate must be positive");
+
+    Processor processor;
+    loadSettings(processor, args);
+
+    SyntheticPlayHead playHead{bpm, timeSignature, startPPQ};
+    processor.setPlayHead(&playHead);
+    processor.setPlayConfigDetails(2, 2, format.sampleRate, blockFrames);
+    processor.prepareToPlay(format.sampleRate, blockFrames);
+
+    if (format.wav && !WavHeader::write(stdout, format)) exitOnOutputError();
+
+    DoubleBufferedReader reader{stdin, format.getFrameBytes(), blockFrames, std::move(prefix)};
+
+    while (true) {
+        auto& block = reader.next();
+        if (block.numFrames == 0) break;
+
+        auto* frames = block.data.data();
+        processor.processInterleaved(frames, format.format, block.numFrames);
+        playHead.advance(block.numFrames, format.sampleRate);
+
+        auto numBytes = static_cast<size_t>(block.numFrames) * static_cast<size_t>(format.getFrameBytes());
+        if (std::fwrite(frames, 1, numBytes, stdout) != numBytes || std::fflush(stdout) != 0) exitOnOutputError();
+
+        reader.release();
+    }
+
+    processor.releaseResources();
+    processor.setPlayHead(nullptr);
+}
+
+auto main(int argc, char* argv[]) -> int {
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "Gain Booster Filter", true);
+    app.addDefaultCommand({
+        "",
+        "[--preset=file.json] [--factory=name] [--state=file] [--input=auto|wav|raw] [--format=f32|s16|s24] "
+        "[--rate=48000] [--block-size=512] [--bpm=120] [--time-signature=4/4] [--start-ppq=0] < input > output",
+        "Processes interleaved stereo PCM from stdin to stdout",
+        "Reads WAV or raw little-endian stereo PCM from stdin, runs it through Gain Booster with the given preset "
+        "or state file and writes the same format to stdout, one block at a time. WAV input sets the format and "
+        "rate from its header. The synced LFOs follow a transport generated from --bpm and --time-signature. "
+        "Latency is one block: stdin is read on its own thread into a second buffer while the first is processed.",
+        runFilter
+    });
+
+    return app.findAndRunCommand(argc, argv);
+}
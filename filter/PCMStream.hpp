@@ -0,0 +1,203 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include "Kernels.h"
+
+struct StreamFormat {
+    PCMFormat format = PCMFormat::float32;
+    double sampleRate = 48000.0;
+    bool wav = false;
+
+    auto getFrameBytes() const -> int {
+        switch (this->format) {
+            case PCMFormat::float32: return 8;
+            case PCMFormat::int16: return 4;
+            case PCMFormat::int24: return 6;
+        }
+        return 8;
+    }
+};
+
+class WavHeader {
+public:
+    static constexpr uint16 pcmTag = 1;
+    static constexpr uint16 floatTag = 3;
+    static constexpr uint16 extensibleTag = 0xfffe;
+    static constexpr size_t maxFormatSize = 40;
+
+    // Parses everything up to the start of the data chunk, "RIFF" has already been consumed
+    static auto read(std::FILE* input, StreamFormat& format) -> String {
+        uint8 riff[8];
+        if (!readBytes(input, riff, sizeof(riff)) || std::memcmp(riff + 4, "WAVE", 4) != 0) return "not a WAVE stream";
+
+        bool hasFormat = false;
+
+        while (true) {
+            uint8 chunk[8];
+            if (!readBytes(input, chunk, sizeof(chunk))) return "no data chunk";
+
+            auto chunkSize = ByteOrder::littleEndianInt(chunk + 4);
+
+            if (std::memcmp(chunk, "data", 4) == 0) {
+                return hasFormat ? String{} : "data chunk before fmt chunk";
+            }
+
+            if (std::memcmp(chunk, "fmt ", 4) == 0) {
+                // Only the extensible layout's fields are read, anything past them and the pad byte is skipped
+                // so a corrupt size can't drive a large allocation
+                if (chunkSize < 16) return "truncated fmt chunk";
+
+                std::array<uint8, maxFormatSize> fmt{};
+                auto formatBytes = jmin(static_cast<size_t>(chunkSize), fmt.size());
+                auto skippedBytes = static_cast<size_t>(chunkSize) - formatBytes + (chunkSize & 1);
+                if (!readBytes(input, fmt.data(), formatBytes) || !skipBytes(input, skippedBytes)) return "truncated fmt chunk";
+
+                auto tag = ByteOrder::littleEndianShort(fmt.data());
+                auto channels = ByteOrder::littleEndianShort(fmt.data() + 2);
+                auto sampleRate = ByteOrder::littleEndianInt(fmt.data() + 4);
+                auto bits = ByteOrder::littleEndianShort(fmt.data() + 14);
+
+                if (tag == extensibleTag && chunkSize >= 26) tag = ByteOrder::littleEndianShort(fmt.data() + 24);
+                if (channels != 2) return "only stereo streams are supported";
+
+                if (tag == floatTag && bits == 32) {
+                    format.format = PCMFormat::float32;
+                } else if (tag == pcmTag && bits == 16) {
+                    format.format = PCMFormat::int16;
+                } else if (tag == pcmTag && bits == 24) {
+                    format.format = PCMFormat::int24;
+                } else {
+                    return "unsupported sample format (" + String(bits) + " bit, tag " + String(tag) + ")";
+                }
+
+                format.sampleRate = static_cast<double>(sampleRate);
+                hasFormat = true;
+                continue;
+            }
+
+            if (!skipBytes(input, static_cast<size_t>(chunkSize) + (chunkSize & 1))) return "truncated chunk";
+        }
+    }
+
+    // Streamed output has no known length, the sizes are left at their maximum like other pipe writers do
+    static auto write(std::FILE* output, const StreamFormat& format) -> bool {
+        uint16 tag = format.format == PCMFormat::float32 ? floatTag : pcmTag;
+        uint16 bits = format.format == PCMFormat::float32 ? 32 : (format.format == PCMFormat::int16 ? 16 : 24);
+        auto blockAlign = static_cast<uint16>(format.getFrameBytes());
+        auto sampleRate = static_cast<uint32>(format.sampleRate);
+
+        MemoryOutputStream header;
+        header.write("RIFF", 4);
+        header.writeInt(-1);
+        header.write("WAVEfmt ", 8);
+        header.writeInt(16);
+        header.writeShort(static_cast<short>(tag));
+        header.writeShort(2);
+        header.writeInt(static_cast<int>(sampleRate));
+        header.writeInt(static_cast<int>(sampleRate * blockAlign));
+        header.writeShort(static_cast<short>(blockAlign));
+        header.writeShort(static_cast<short>(bits));
+        header.write("data", 4);
+        header.writeInt(-1);
+
+        return std::fwrite(header.getData(), 1, header.getDataSize(), output) == header.getDataSize();
+    }
+
+private:
+    static auto readBytes(std::FILE* input, void* dest, size_t numBytes) -> bool {
+        return std::fread(dest, 1, numBytes, input) == numBytes;
+    }
+
+    static auto skipBytes(std::FILE* input, size_t numBytes) -> bool {
+        uint8 scratch[4096];
+
+        while (numBytes > 0) {
+            auto chunk = jmin(numBytes, sizeof(scratch));
+            if (!readBytes(input, scratch, chunk)) return false;
+            numBytes -= chunk;
+        }
+        return true;
+    }
+};
+
+// Reads whole frames from a blocking stream on its own thread, filling one block while the other is processed
+class DoubleBufferedReader : private Thread {
+public:
+    struct Block {
+        std::vector<uint8> data;
+        int numFrames = 0;
+    };
+
+    DoubleBufferedReader(std::FILE* input, int frameBytes, int blockFrames, MemoryBlock prefix)
+        : Thread("Gain Booster Reader"), input(input), frameBytes(frameBytes), prefix(std::move(prefix)) {
+        for (auto& slot : this->slots) {
+            slot.block.data.resize(static_cast<size_t>(frameBytes) * static_cast<size_t>(blockFrames));
+            slot.free.signal();
+        }
+        this->startThread(Thread::Priority::high);
+    }
+
+    ~DoubleBufferedReader() override {
+        this->signalThreadShouldExit();
+        for (auto& slot : this->slots) slot.free.signal();
+        this->stopThread(-1);
+    }
+
+    // Waits for the next block, an empty block marks the end of the stream
+    auto next() -> Block& {
+        auto& slot = this->slots[this->readIndex];
+        slot.filled.wait();
+        return slot.block;
+    }
+
+    // Hands the block returned by next() back to the reader thread
+    auto release() -> void {
+        this->slots[this->readIndex].free.signal();
+        this->readIndex ^= 1;
+    }
+
+private:
+    struct Slot {
+        Block block;
+        WaitableEvent filled;
+        WaitableEvent free;
+    };
+
+    std::FILE* input;
+    int frameBytes;
+    MemoryBlock prefix;
+    std::array<Slot, 2> slots;
+    size_t readIndex = 0;
+
+    auto run() -> void override {
+        size_t writeIndex = 0;
+        bool endOfStream = false;
+        int numFrames = -1;
+
+        // The stream always ends with an empty block so next() sees the end even after a full final block
+        while (numFrames != 0) {
+            auto& slot = this->slots[writeIndex];
+            slot.free.wait();
+            if (this->threadShouldExit()) return;
+
+            auto& data = slot.block.data;
+            size_t filled = jmin(this->prefix.getSize(), data.size());
+            std::memcpy(data.data(), this->prefix.getData(), filled);
+            this->prefix.removeSection(0, filled);
+
+            while (!endOfStream && filled < data.size()) {
+                auto count = std::fread(data.data() + filled, 1, data.size() - filled, this->input);
+                endOfStream = count == 0;
+                filled += count;
+            }
+
+            // A trailing partial frame is dropped
+            numFrames = static_cast<int>(filled / static_cast<size_t>(this->frameBytes));
+            slot.block.numFrames = numFrames;
+            slot.filled.signal();
+            writeIndex ^= 1;
+        }
+    }
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Stands in for a host transport so the synced LFOs run from the command line tempo
+class SyntheticPlayHead : public AudioPlayHead {
+public:
+    SyntheticPlayHead(double bpm, AudioPlayHead::TimeSignature timeSignature, double startPPQ)
+        : bpm(bpm), timeSignature(timeSignature), ppq(startPPQ) {}
+
+    auto getPosition() const -> Optional<PositionInfo> override {
+        PositionInfo info;
+        info.setBpm(this->bpm);
+        info.setTimeSignature(this->timeSignature);
+        info.setPpqPosition(this->ppq);
+        info.setTimeInSamples(this->timeInSamples);
+        info.setIsPlaying(true);
+        return info;
+    }
+
+    auto advance(int numFrames, double sampleRate) -> void {
+        this->timeInSamples += numFrames;
+        this->ppq += static_cast<double>(numFrames) / sampleRate * (this->bpm / 60.0);
+    }
+
+private:
+    double bpm;
+    AudioPlayHead::TimeSignature timeSignature;
+    double ppq;
+    int64 timeInSamples = 0;
+};
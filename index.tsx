@@ -3,6 +3,7 @@ import {createRoot} from "react-dom/client"
 import Knob from "./components/Knob"
 import LFOBar from "./components/LFOBar"
 import PresetBar from "./components/PresetBar"
+import CPUMeter from "./components/CPUMeter"
 import parameters from "./processor/parameters.json"
 import dark from "./assets/dark.png"
 import light from "./assets/light.png"
@@ -26,6 +27,7 @@ export const ThemeContext = React.createContext<ThemeContextType>({theme: "", se
 
 const App: React.FunctionComponent = () => {
     const [theme, setTheme] = useState(localStorage.getItem("theme") || "dark")
+    const [showCPU, setShowCPU] = useState(localStorage.getItem("showCPU") === "true")
 
     useEffect(() => {
         const colorList = theme === "light" ? lightColorList : darkColorList
@@ -35,17 +37,26 @@ const App: React.FunctionComponent = () => {
         localStorage.setItem("theme", theme)
     }, [theme])
 
+    useEffect(() => {
+        localStorage.setItem("showCPU", String(showCPU))
+    }, [showCPU])
+
     const toggleTheme = () => {
         setTheme((prev) => prev === "light" ? "dark" : "light")
     }
 
+    const toggleCPU = () => {
+        setShowCPU((prev) => !prev)
+    }
+
     const filter = functions.calculateFilter("#ff0db2")
 
     return (
         <div className="app">
             <ThemeContext.Provider value={{theme, setTheme}}>
             <div className="title-container">
-                <span className="title-text">Gain <span className="title-highlight">Booster</span></span>
+                <span className="title-text" onDoubleClick={toggleCPU}>Gain <span className="title-highlight">Booster</span></span>
+                {showCPU ? <CPUMeter/> : null}
                 <img className="theme-icon" src={theme === "light" ? dark : light} style={{filter}}onClick={toggleTheme} draggable={false}/>
             </div>
             <div className="knobs-container">
@@ -78,12 +89,14 @@ const App: React.FunctionComponent = () => {
                     lfoTypeID={parameters.gainLFOType.id} 
                     lfoRateID={parameters.gainLFORate.id} 
                     lfoAmountID={parameters.gainLFOAmount.id} 
+                    target="gain"
                     color="#ff0db2"/>
                 <LFOBar 
                     label={parameters.pan.id.toUpperCase()} 
                     lfoTypeID={parameters.panLFOType.id} 
                     lfoRateID={parameters.panLFORate.id} 
                     lfoAmountID={parameters.panLFOAmount.id}  
+                    target="pan"
                     color="#460dff"/>
             </div>
             <div className="preset-container">
@@ -0,0 +1,88 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+#include "Kernels.h"
+
+class AudioSafety {
+public:
+    struct Counters {
+        uint64_t nonFiniteSamples = 0;
+        uint64_t outOfRangeSamples = 0;
+        uint64_t repairedBlocks = 0;
+    };
+
+    // 0 dBFS input at the maximum 12 dB boost. Louder samples are only counted, hot upstream material passes untouched
+    static constexpr double sampleLimit = 4.0;
+    static constexpr int fadeLength = 32;
+
+    // Zeroes NaN and Inf with a short fade either side, repairedBlocks is set when that happened
+    template <typename SampleType>
+    auto process(AudioBuffer<SampleType>& buffer, const KernelTable<SampleType>& kernels) noexcept -> Counters {
+        auto limit = static_cast<SampleType>(AudioSafety::sampleLimit);
+        Counters blockCounters;
+
+        for (int channel = 0; channel < buffer.getNumChannels(); channel++) {
+            auto* channelData = buffer.getWritePointer(channel);
+            auto stats = kernels.measureBlock(channelData, buffer.getNumSamples(), limit);
+
+            blockCounters.outOfRangeSamples += static_cast<uint64_t>(stats.outOfRange);
+            if (stats.nonFinite == 0) continue;
+
+            blockCounters.nonFiniteSamples += static_cast<uint64_t>(stats.nonFinite);
+            blockCounters.repairedBlocks = 1;
+            AudioSafety::repair(channelData, buffer.getNumSamples());
+        }
+
+        if (blockCounters.outOfRangeSamples > 0) {
+            this->outOfRangeSamples.fetch_add(blockCounters.outOfRangeSamples, std::memory_order_relaxed);
+        }
+
+        if (blockCounters.repairedBlocks > 0) {
+            this->nonFiniteSamples.fetch_add(blockCounters.nonFiniteSamples, std::memory_order_relaxed);
+            this->repairedBlocks.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return blockCounters;
+    }
+
+    auto getCounters() const noexcept -> Counters {
+        return {
+            this->nonFiniteSamples.load(std::memory_order_relaxed),
+            this->outOfRangeSamples.load(std::memory_order_relaxed),
+            this->repairedBlocks.load(std::memory_order_relaxed)
+        };
+    }
+
+private:
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+    std::atomic<uint64_t> nonFiniteSamples{0};
+    std::atomic<uint64_t> outOfRangeSamples{0};
+    std::atomic<uint64_t> repairedBlocks{0};
+
+    template <typename SampleType>
+    static auto repair(SampleType* data, int numSamples) noexcept -> void {
+        int sample = 0;
+
+        while (sample < numSamples) {
+            if (std::isfinite(data[sample])) {
+                sample++;
+                continue;
+            }
+
+            int start = sample;
+            while (sample < numSamples && !std::isfinite(data[sample])) {
+                data[sample++] = SampleType(0);
+            }
+
+            for (int offset = 1; offset <= AudioSafety::fadeLength && start - offset >= 0; offset++) {
+                data[start - offset] *= static_cast<SampleType>(offset) / static_cast<SampleType>(AudioSafety::fadeLength + 1);
+            }
+
+            for (int offset = 0; offset < AudioSafety::fadeLength && sample + offset < numSamples; offset++) {
+                data[sample + offset] *= static_cast<SampleType>(offset + 1) / static_cast<SampleType>(AudioSafety::fadeLength + 1);
+            }
+        }
+    }
+};
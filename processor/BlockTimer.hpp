@@ -0,0 +1,132 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+class BlockTimer {
+public:
+    struct Snapshot {
+        uint64 blocks = 0;
+        uint64 samples = 0;
+        double lastNsPerSample = 0.0;
+        double averageNsPerSample = 0.0;
+        double maxNsPerSample = 0.0;
+        double p50NsPerSample = 0.0;
+        double p90NsPerSample = 0.0;
+        double p99NsPerSample = 0.0;
+        double cpuLoad = 0.0;
+    };
+
+    // Quarter-octave buckets from 1ns to ~65us per sample
+    static constexpr int numBuckets = 64;
+    static constexpr double bucketsPerOctave = 4.0;
+    // The max and the percentiles cover the current window plus the previous one, so 2 to 4 seconds
+    static constexpr double maxWindowSeconds = 2.0;
+
+    auto reset() noexcept -> void {
+        this->blocks.store(0, std::memory_order_relaxed);
+        this->samples.store(0, std::memory_order_relaxed);
+        this->totalTicks.store(0, std::memory_order_relaxed);
+        this->lastNsPerSample.store(0.0, std::memory_order_relaxed);
+        this->lastLoad.store(0.0, std::memory_order_relaxed);
+        this->currentMax.store(0.0, std::memory_order_relaxed);
+        this->previousMax.store(0.0, std::memory_order_relaxed);
+        this->windowSamples = 0.0;
+
+        for (auto& histogram : this->histograms) {
+            for (auto& bucket : histogram) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+        this->currentHistogram.store(0, std::memory_order_relaxed);
+    }
+
+    auto record(int numSamples, double sampleRate, int64 elapsedTicks) noexcept -> void {
+        if (numSamples <= 0 || sampleRate <= 0.0) return;
+
+        double elapsedNs = Time::highResolutionTicksToSeconds(elapsedTicks) * 1.0e9;
+        double nsPerSample = elapsedNs / numSamples;
+
+        this->blocks.fetch_add(1, std::memory_order_relaxed);
+        this->samples.fetch_add(static_cast<uint64>(numSamples), std::memory_order_relaxed);
+        this->totalTicks.fetch_add(elapsedTicks, std::memory_order_relaxed);
+        this->lastNsPerSample.store(nsPerSample, std::memory_order_relaxed);
+        this->lastLoad.store(nsPerSample * sampleRate * 1.0e-9, std::memory_order_relaxed);
+
+        this->windowSamples += numSamples;
+        if (this->windowSamples > sampleRate * BlockTimer::maxWindowSeconds) {
+            this->previousMax.store(this->currentMax.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            this->currentMax.store(0.0, std::memory_order_relaxed);
+            this->windowSamples = 0.0;
+
+            // The oldest window's buckets are cleared and become the current ones
+            auto next = 1 - this->currentHistogram.load(std::memory_order_relaxed);
+            for (auto& count : this->histograms[static_cast<size_t>(next)]) {
+                count.store(0, std::memory_order_relaxed);
+            }
+            this->currentHistogram.store(next, std::memory_order_relaxed);
+        }
+
+        if (nsPerSample > this->currentMax.load(std::memory_order_relaxed)) {
+            this->currentMax.store(nsPerSample, std::memory_order_relaxed);
+        }
+
+        auto bucket = static_cast<size_t>(jlimit(0, BlockTimer::numBuckets - 1,
+            static_cast<int>(std::log2(nsPerSample + 1.0) * BlockTimer::bucketsPerOctave)));
+        auto current = static_cast<size_t>(this->currentHistogram.load(std::memory_order_relaxed));
+        this->histograms[current][bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto getSnapshot() const noexcept -> Snapshot {
+        Snapshot snapshot;
+        snapshot.blocks = this->blocks.load(std::memory_order_relaxed);
+        snapshot.samples = this->samples.load(std::memory_order_relaxed);
+        snapshot.lastNsPerSample = this->lastNsPerSample.load(std::memory_order_relaxed);
+        snapshot.maxNsPerSample = jmax(this->currentMax.load(std::memory_order_relaxed),
+            this->previousMax.load(std::memory_order_relaxed));
+        snapshot.cpuLoad = this->lastLoad.load(std::memory_order_relaxed);
+
+        if (snapshot.samples > 0) {
+            double totalNs = Time::highResolutionTicksToSeconds(this->totalTicks.load(std::memory_order_relaxed)) * 1.0e9;
+            snapshot.averageNsPerSample = totalNs / static_cast<double>(snapshot.samples);
+        }
+
+        std::array<uint32, BlockTimer::numBuckets> counts;
+        uint64 total = 0;
+
+        for (size_t i = 0; i < counts.size(); i++) {
+            counts[i] = this->histograms[0][i].load(std::memory_order_relaxed) + this->histograms[1][i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+
+        auto percentile = [&](double fraction) -> double {
+            if (total == 0) return 0.0;
+            auto target = static_cast<uint64>(std::ceil(fraction * static_cast<double>(total)));
+            uint64 running = 0;
+
+            for (size_t i = 0; i < counts.size(); i++) {
+                running += counts[i];
+                if (running >= target) return std::exp2(static_cast<double>(i + 1) / BlockTimer::bucketsPerOctave) - 1.0;
+            }
+            return snapshot.maxNsPerSample;
+        };
+
+        snapshot.p50NsPerSample = percentile(0.5);
+        snapshot.p90NsPerSample = percentile(0.9);
+        snapshot.p99NsPerSample = percentile(0.99);
+
+        return snapshot;
+    }
+
+private:
+    std::atomic<uint64> blocks{0};
+    std::atomic<uint64> samples{0};
+    std::atomic<int64> totalTicks{0};
+    std::atomic<double> lastNsPerSample{0.0};
+    std::atomic<double> lastLoad{0.0};
+    std::atomic<double> currentMax{0.0};
+    std::atomic<double> previousMax{0.0};
+    std::array<std::array<std::atomic<uint32>, BlockTimer::numBuckets>, 2> histograms{};
+    std::atomic<int> currentHistogram{0};
+    double windowSamples = 0.0;
+};
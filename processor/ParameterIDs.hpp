@@ -1,6 +1,8 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include "BinaryData.h"
+#include "StreamParameters.hpp"
 
 class ParameterIDs {
 public:
@@ -17,6 +19,18 @@ public:
     ParameterID panLFORate;
     ParameterID panLFOAmount;
 
+    std::array<ParameterID, StreamParameters::numLFOs - 2> auxLFOType;
+    std::array<ParameterID, StreamParameters::numLFOs - 2> auxLFORate;
+    std::array<ParameterID, StreamParameters::numRoutings> modSource;
+    std::array<ParameterID, StreamParameters::numRoutings> modDestination;
+    std::array<ParameterID, StreamParameters::numRoutings> modDepth;
+
+    ParameterID duckAmount;
+    ParameterID duckAttack;
+    ParameterID duckRelease;
+    ParameterID gainLFOMode;
+    ParameterID gainLFOFrequency;
+
     static inline var parsedJSON;
 
     static auto getJSON() -> DynamicObject* {
@@ -57,6 +71,25 @@ public:
         parameterIDs.panLFORate = getParameter("panLFORate");
         parameterIDs.panLFOAmount = getParameter("panLFOAmount");
 
+        for (size_t aux = 0; aux < parameterIDs.auxLFOType.size(); aux++) {
+            auto prefix = "lfo" + String(static_cast<int>(aux) + 3);
+            parameterIDs.auxLFOType[aux] = getParameter(prefix + "Type");
+            parameterIDs.auxLFORate[aux] = getParameter(prefix + "Rate");
+        }
+
+        for (size_t slot = 0; slot < parameterIDs.modSource.size(); slot++) {
+            auto prefix = "mod" + String(static_cast<int>(slot) + 1);
+            parameterIDs.modSource[slot] = getParameter(prefix + "Source");
+            parameterIDs.modDestination[slot] = getParameter(prefix + "Destination");
+            parameterIDs.modDepth[slot] = getParameter(prefix + "Depth");
+        }
+
+        parameterIDs.duckAmount = getParameter("duckAmount");
+        parameterIDs.duckAttack = getParameter("duckAttack");
+        parameterIDs.duckRelease = getParameter("duckRelease");
+        parameterIDs.gainLFOMode = getParameter("gainLFOMode");
+        parameterIDs.gainLFOFrequency = getParameter("gainLFOFrequency");
+
         return parameterIDs;
     }
 
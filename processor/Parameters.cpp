@@ -1,6 +1,6 @@
 #include "Parameters.h"
-#include "PanningLaw.hpp"
-#include "Functions.hpp"
+#include "ParameterText.hpp"
+#include "Trace.hpp"
 
 template<typename T>
 static auto castParameter(const AudioProcessorValueTreeState& tree, 
@@ -9,23 +9,10 @@ static auto castParameter(const AudioProcessorValueTreeState& tree,
     jassert(dest != nullptr);
 }
 
-template <typename T>
-static auto resetParameter(const AudioProcessorValueTreeState& tree, 
-    const AudioParameterFloat* param, T*& dest) -> void {
-    auto* paramObj = tree.getParameter(param->getParameterID());
-    if (paramObj) *dest = paramObj->getDefaultValue();
-}
-
-template <typename T>
-static auto resetParameter(const AudioProcessorValueTreeState& tree, 
-    const AudioParameterChoice* param, T*& dest) -> void {
-    auto* paramObj = tree.getParameter(param->getParameterID());
-    if (paramObj) *dest = static_cast<T>(paramObj->getDefaultValue());
-}
-
 ParameterIDs Parameters::paramIDs = ParameterIDs::loadFromJSON();
 
-Parameters::Parameters(AudioProcessorValueTreeState& tree) : tree(tree) {
+Parameters::Parameters(AudioProcessorValueTreeState& tree, RealtimeLog& realtimeLog) : 
+    tree(tree), realtimeLog(realtimeLog) {
     using FloatPair = std::pair<AudioParameterFloat*&, const ParameterID*>;
     using ChoicePair = std::pair<AudioParameterChoice*&, const ParameterID*>;
 
@@ -36,7 +23,11 @@ Parameters::Parameters(AudioProcessorValueTreeState& tree) : tree(tree) {
         {gainLFORateParam, &paramIDs.gainLFORate},
         {gainLFOAmountParam, &paramIDs.gainLFOAmount},
         {panLFORateParam, &paramIDs.panLFORate},
-        {panLFOAmountParam, &paramIDs.panLFOAmount}
+        {panLFOAmountParam, &paramIDs.panLFOAmount},
+        {duckAmountParam, &paramIDs.duckAmount},
+        {duckAttackParam, &paramIDs.duckAttack},
+        {duckReleaseParam, &paramIDs.duckRelease},
+        {gainLFOFrequencyParam, &paramIDs.gainLFOFrequency}
     };
 
     auto choiceParameters = std::vector<ChoicePair>{
@@ -44,9 +35,21 @@ Parameters::Parameters(AudioProcessorValueTreeState& tree) : tree(tree) {
         {boostCurveParam, &paramIDs.boostCurve},
         {panningLawParam, &paramIDs.panningLaw},
         {gainLFOTypeParam, &paramIDs.gainLFOType},
-        {panLFOTypeParam, &paramIDs.panLFOType}
+        {panLFOTypeParam, &paramIDs.panLFOType},
+        {gainLFOModeParam, &paramIDs.gainLFOMode}
     };
 
+    for (size_t aux = 0; aux < auxLFOTypeParams.size(); aux++) {
+        choiceParameters.emplace_back(auxLFOTypeParams[aux], &paramIDs.auxLFOType[aux]);
+        floatParameters.emplace_back(auxLFORateParams[aux], &paramIDs.auxLFORate[aux]);
+    }
+
+    for (size_t slot = 0; slot < modSourceParams.size(); slot++) {
+        choiceParameters.emplace_back(modSourceParams[slot], &paramIDs.modSource[slot]);
+        choiceParameters.emplace_back(modDestinationParams[slot], &paramIDs.modDestination[slot]);
+        floatParameters.emplace_back(modDepthParams[slot], &paramIDs.modDepth[slot]);
+    }
+
     for (auto& [param, paramID] : floatParameters) {
         castParameter(tree, paramID, param);
     }
@@ -54,6 +57,9 @@ Parameters::Parameters(AudioProcessorValueTreeState& tree) : tree(tree) {
     for (auto& [param, paramID] : choiceParameters) {
         castParameter(tree, paramID, param);
     }
+
+    this->floatStream.setScope(&this->modulationScope);
+    this->doubleStream.setScope(&this->modulationScope);
 }
 
 auto Parameters::createParameterLayout() -> AudioProcessorValueTreeState::ParameterLayout {
@@ -61,8 +67,8 @@ auto Parameters::createParameterLayout() -> AudioProcessorValueTreeState::Parame
 
     layout.add(std::make_unique<AudioParameterFloat>(
         paramIDs.gain, "Gain", NormalisableRange<float>{0.0f, 1.0f, 0.01f}, 1.0f,
-        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayPercent)
-        .withValueFromStringFunction(Functions::parsePercent)
+        AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayPercent)
+        .withValueFromStringFunction(ParameterText::parsePercent)
     ));
 
     layout.add(std::make_unique<AudioParameterChoice>(
@@ -71,8 +77,8 @@ auto Parameters::createParameterLayout() -> AudioProcessorValueTreeState::Parame
 
     layout.add(std::make_unique<AudioParameterFloat>(
         paramIDs.boost, "Boost", NormalisableRange<float>{0.0f, 12.0f, 0.01f}, 0.0f,
-        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayDecibels)
-        .withValueFromStringFunction(Functions::parseDecibels)
+        AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayDecibels)
+        .withValueFromStringFunction(ParameterText::parseDecibels)
     ));
 
     layout.add(std::make_unique<AudioParameterChoice>(
@@ -81,8 +87,8 @@ auto Parameters::createParameterLayout() -> AudioProcessorValueTreeState::Parame
 
     layout.add(std::make_unique<AudioParameterFloat>(
         paramIDs.pan, "Pan", NormalisableRange<float>{-1.0f, 1.0f, 0.01f}, 0.0f,
-        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayPan)
-        .withValueFromStringFunction(Functions::parsePan)
+        AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayPan)
+        .withValueFromStringFunction(ParameterText::parsePan)
     ));
 
     layout.add(std::make_unique<AudioParameterChoice>(
@@ -95,14 +101,14 @@ auto Parameters::createParameterLayout() -> AudioProcessorValueTreeState::Parame
 
     layout.add(std::make_unique<AudioParameterFloat>(
         paramIDs.gainLFORate, "Gain LFO Rate", NormalisableRange<float>{0.03125f, 4.0f, 0.0001f}, 0.25f,
-        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayLFORate)
-        .withValueFromStringFunction(Functions::parseLFORate)
+        AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayLFORate)
+        .withValueFromStringFunction(ParameterText::parseLFORate)
     ));
 
     layout.add(std::make_unique<AudioParameterFloat>(
         paramIDs.gainLFOAmount, "Gain LFO Amount", NormalisableRange<float>{0.0f, 1.0f, 0.01f}, 0.0f,
-        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayPercent)
-        .withValueFromStringFunction(Functions::parsePercent)
+        AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayPercent)
+        .withValueFromStringFunction(ParameterText::parsePercent)
     ));
 
     layout.add(std::make_unique<AudioParameterChoice>(
@@ -111,155 +117,164 @@ auto Parameters::createParameterLayout() -> AudioProcessorValueTreeState::Parame
 
     layout.add(std::make_unique<AudioParameterFloat>(
         paramIDs.panLFORate, "Pan LFO Rate", NormalisableRange<float>{0.03125f, 4.0f, 0.0001f}, 0.25f,
-        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayLFORate)
-        .withValueFromStringFunction(Functions::parseLFORate)
+        AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayLFORate)
+        .withValueFromStringFunction(ParameterText::parseLFORate)
     ));
 
     layout.add(std::make_unique<AudioParameterFloat>(
         paramIDs.panLFOAmount, "Pan LFO Amount", NormalisableRange<float>{0.0f, 1.0f, 0.01f}, 0.0f,
-        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayPercent)
-        .withValueFromStringFunction(Functions::parsePercent)
+        AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayPercent)
+        .withValueFromStringFunction(ParameterText::parsePercent)
     ));
 
-    return layout;
-}
+    for (size_t aux = 0; aux < paramIDs.auxLFOType.size(); aux++) {
+        auto name = "LFO " + String(static_cast<int>(aux) + 3);
 
-auto Parameters::getDefaultParameter(const Array<var>& args,
-    WebBrowserComponent::NativeFunctionCompletion completion) -> void {
+        layout.add(std::make_unique<AudioParameterChoice>(
+            paramIDs.auxLFOType[aux], name + " Type", StringArray{"square", "saw", "triangle", "sine"}, 3
+        ));
 
-    auto paramID = args[0].toString();
-    auto* param = this->tree.getParameter(paramID);
-    float defaultValue = param->convertFrom0to1(param->getDefaultValue());
+        layout.add(std::make_unique<AudioParameterFloat>(
+            paramIDs.auxLFORate[aux], name + " Rate", NormalisableRange<float>{0.03125f, 4.0f, 0.0001f}, 0.25f,
+            AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayLFORate)
+            .withValueFromStringFunction(ParameterText::parseLFORate)
+        ));
+    }
 
-    completion(defaultValue);
-}
+    // Destination choices follow ModulationMatrix's order: off, gain, boost, pan, LFO rates, LFO amounts
+    StringArray lfoNames{"gain lfo", "pan lfo", "lfo 3", "lfo 4"};
+    StringArray destinations{"off", "gain", "boost", "pan"};
+    for (const auto& lfo : lfoNames) destinations.add(lfo + " rate");
+    for (const auto& lfo : lfoNames) destinations.add(lfo + " amount");
 
-auto Parameters::prepareToPlay(double sampleRate, int blockSize) noexcept -> void {
-    this->sampleRate = sampleRate;
-    this->blockSize = blockSize;
-    double duration = 0.001;
-
-    auto smoothers = std::vector{
-        &gainSmoother,
-        &boostSmoother,
-        &panSmoother,
-        &gainLFOAmountSmoother,
-        &panLFOAmountSmoother
-    };
+    for (size_t slot = 0; slot < paramIDs.modSource.size(); slot++) {
+        auto name = "Mod " + String(static_cast<int>(slot) + 1);
+
+        layout.add(std::make_unique<AudioParameterChoice>(
+            paramIDs.modSource[slot], name + " Source", lfoNames, 2
+        ));
+
+        layout.add(std::make_unique<AudioParameterChoice>(
+            paramIDs.modDestination[slot], name + " Destination", destinations, 0
+        ));
 
-    for (const auto& smoother : smoothers) {
-        smoother->reset(this->sampleRate, duration);
+        layout.add(std::make_unique<AudioParameterFloat>(
+            paramIDs.modDepth[slot], name + " Depth", NormalisableRange<float>{-1.0f, 1.0f, 0.01f}, 0.0f,
+            AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayPercent)
+            .withValueFromStringFunction(ParameterText::parsePercent)
+        ));
     }
 
-    this->gainLFO.prepareToPlay(this->sampleRate);
-    this->panLFO.prepareToPlay(this->sampleRate);
-}
+    layout.add(std::make_unique<AudioParameterFloat>(
+        paramIDs.duckAmount, "Duck Amount", NormalisableRange<float>{0.0f, 1.0f, 0.01f}, 0.0f,
+        AudioParameterFloatAttributes().withStringFromValueFunction(ParameterText::displayPercent)
+        .withValueFromStringFunction(ParameterText::parsePercent)
+    ));
 
-auto Parameters::reset() noexcept -> void {
-    auto paramFloats = std::vector{
-        std::pair{gainParam, &gain},
-        std::pair{boostParam, &boost},
-        std::pair{panParam, &pan}
-    };
+    layout.add(std::make_unique<AudioParameterFloat>(
+        paramIDs.duckAttack, "Duck Attack", NormalisableRange<float>{0.1f, 100.0f, 0.1f, 0.4f}, 5.0f,
+        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayMilliseconds)
+        .withValueFromStringFunction(Functions::parseMilliseconds)
+    ));
 
-    for (auto& [param, value] : paramFloats) {
-        resetParameter(tree, param, value);
-    }
-    
-    auto smoothers = std::vector{
-        std::pair{gainParam, &gainSmoother},
-        std::pair{boostParam, &boostSmoother},
-        std::pair{panParam, &panSmoother},
-        std::pair{gainLFOAmountParam, &gainLFOAmountSmoother},
-        std::pair{panLFOAmountParam, &panLFOAmountSmoother}
-    };
+    layout.add(std::make_unique<AudioParameterFloat>(
+        paramIDs.duckRelease, "Duck Release", NormalisableRange<float>{10.0f, 1000.0f, 1.0f, 0.4f}, 150.0f,
+        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayMilliseconds)
+        .withValueFromStringFunction(Functions::parseMilliseconds)
+    ));
 
-    for (const auto& [param, smoother] : smoothers) {
-        smoother->setCurrentAndTargetValue(param->get());
-    }
+    layout.add(std::make_unique<AudioParameterChoice>(
+        paramIDs.gainLFOMode, "Gain LFO Mode", StringArray{"synced", "tremolo", "ring"}, 0
+    ));
 
-    this->gainLFO.reset();
-    this->panLFO.reset();
+    layout.add(std::make_unique<AudioParameterFloat>(
+        paramIDs.gainLFOFrequency, "Gain LFO Frequency", NormalisableRange<float>{0.1f, 5000.0f, 0.01f, 0.2f}, 8.0f,
+        AudioParameterFloatAttributes().withStringFromValueFunction(Functions::displayHertz)
+        .withValueFromStringFunction(Functions::parseHertz)
+    ));
+
+    return layout;
 }
 
-auto Parameters::setHostInfo(double bpm, double ppq, const AudioPlayHead::TimeSignature& timeSignature) noexcept -> void {
-    this->bpm = bpm;
-    this->ppq = ppq;
-    this->timeSignature = timeSignature;
-
-    if (ppq > 0.0) {
-        this->ppq = ppq;
-        this->internalPPQ = ppq;
-    } else {
-        double ppqPerSample = (this->bpm / 60.0) / this->sampleRate;
-        this->internalPPQ += ppqPerSample * this->blockSize; 
-        this->ppq = this->internalPPQ;
-    }
+auto Parameters::prepareToPlay(double sampleRate, int blockSize) noexcept -> void {
+    this->kernelISA = Kernels::detectISA();
 
-    this->gainLFO.syncToHost(this->bpm, this->ppq, this->timeSignature);
-    this->panLFO.syncToHost(this->bpm, this->ppq, this->timeSignature);
-}
+    this->modulationScope.prepare(sampleRate);
 
-auto Parameters::blockUpdate() noexcept -> void {
-    auto smoothers = std::vector{
-        std::pair{gainParam, &gainSmoother},
-        std::pair{boostParam, &boostSmoother},
-        std::pair{panParam, &panSmoother},
-        std::pair{gainLFOAmountParam, &gainLFOAmountSmoother},
-        std::pair{panLFOAmountParam, &panLFOAmountSmoother}
-    };
+    this->floatStream.prepare(sampleRate, blockSize, this->kernelISA);
+    this->doubleStream.prepare(sampleRate, blockSize, this->kernelISA);
+}
 
-    for (const auto& [param, smoother] : smoothers) {
-        smoother->setTargetValue(param->get());
+auto Parameters::getStreamParameters() const noexcept -> StreamParameters {
+    StreamParameters parameters;
+
+    parameters.gain = this->gainParam->get();
+    parameters.gainCurve = static_cast<ResponseCurve>(this->gainCurveParam->getIndex());
+    parameters.boost = this->boostParam->get();
+    parameters.boostCurve = static_cast<ResponseCurve>(this->boostCurveParam->getIndex());
+    parameters.pan = this->panParam->get();
+    parameters.panningLaw = static_cast<PanLaw>(this->panningLawParam->getIndex());
+
+    parameters.gainLFOType = static_cast<LFOShape>(this->gainLFOTypeParam->getIndex());
+    parameters.gainLFORate = this->gainLFORateParam->get();
+    parameters.gainLFOAmount = this->gainLFOAmountParam->get();
+    parameters.gainLFOMode = static_cast<LFOMode>(this->gainLFOModeParam->getIndex());
+    parameters.gainLFOFrequency = this->gainLFOFrequencyParam->get();
+
+    parameters.panLFOType = static_cast<LFOShape>(this->panLFOTypeParam->getIndex());
+    parameters.panLFORate = this->panLFORateParam->get();
+    parameters.panLFOAmount = this->panLFOAmountParam->get();
+
+    for (size_t aux = 0; aux < parameters.auxLFOType.size(); aux++) {
+        parameters.auxLFOType[aux] = static_cast<LFOShape>(this->auxLFOTypeParams[aux]->getIndex());
+        parameters.auxLFORate[aux] = this->auxLFORateParams[aux]->get();
     }
 
-    this->gainLFO.setType(this->gainLFOTypeParam->getCurrentChoiceName());
-    this->panLFO.setType(this->panLFOTypeParam->getCurrentChoiceName());
+    for (size_t slot = 0; slot < parameters.routings.size(); slot++) {
+        auto& routing = parameters.routings[slot];
+        routing.source = this->modSourceParams[slot]->getIndex();
+        routing.destination = this->modDestinationParams[slot]->getIndex();
+        routing.depth = this->modDepthParams[slot]->get();
+    }
 
-    float gainLFOSyncedTime = this->gainLFORateParam->get();
-    float panLFOSyncedTime = this->panLFORateParam->get();
+    parameters.duckAmount = this->duckAmountParam->get();
+    parameters.duckAttack = this->duckAttackParam->get();
+    parameters.duckRelease = this->duckReleaseParam->get();
 
-    this->gainLFO.setSyncedRate(gainLFOSyncedTime);
-    this->panLFO.setSyncedRate(panLFOSyncedTime);
+    return parameters;
 }
 
-auto Parameters::update() noexcept -> void {
-    const auto& gainCurve = this->gainCurveParam->getCurrentChoiceName();
-    this->gain = gainSmoother.getNextValue();
-
-    if (gainCurve == "logarithmic") {
-        this->gain = std::pow(this->gain, 0.5f);
-    } else if (gainCurve == "exponential") {
-        this->gain = std::pow(this->gain, 2.0f);
-    }
+auto Parameters::reset() noexcept -> void {
+    auto parameters = this->getStreamParameters();
 
-    float gainLFOValue = this->gainLFO.getSample();
-    float gainLFOAmount = this->gainLFOAmountSmoother.getNextValue();
-    this->gain *= jmap(gainLFOValue, -1.0f, 1.0f, 1.0f - gainLFOAmount, 1.0f);
+    this->floatStream.reset(parameters);
+    this->doubleStream.reset(parameters);
+}
 
-    const auto& boostCurve = this->boostCurveParam->getCurrentChoiceName();
-    float boostdB = this->boostSmoother.getNextValue();
+template <typename SampleType>
+auto Parameters::setHostInfo(double bpm, std::optional<double> ppq, const AudioPlayHead::TimeSignature& timeSignature, bool isPlaying) noexcept -> void {
+    auto events = this->getStream<SampleType>().setTransport({bpm, ppq.value_or(0.0), timeSignature.numerator, timeSignature.denominator, isPlaying, ppq.has_value()});
 
-    if (boostCurve == "logarithmic") {
-        boostdB = std::pow(boostdB / 12.0f, 0.5f) * 12.0f;
-    } else if (boostCurve == "exponential") {
-        boostdB = std::pow(boostdB / 12.0f, 2.0f) * 12.0f;
+    if (events.jumped) {
+        this->realtimeLog.push(LogEvent::transportJump, events.previousPPQ, events.ppq);
     }
 
-    this->boost = Decibels::decibelsToGain(boostdB);
+    if (events.gainLFORetriggered) {
+        this->realtimeLog.push(LogEvent::lfoRetrigger, 0.0, events.ppq);
+    }
 
-    const auto& panningLaw = panningLawParam->getCurrentChoiceName();
-    this->pan = this->panSmoother.getNextValue();
+    if (events.panLFORetriggered) {
+        this->realtimeLog.push(LogEvent::lfoRetrigger, 1.0, events.ppq);
+    }
+}
 
-    float panLFOValue = this->panLFO.getSample();
-    float panLFOAmount = this->panLFOAmountSmoother.getNextValue();
-    this->pan = jlimit(-1.0f, 1.0f, this->pan + panLFOValue * panLFOAmount * 0.5f);
+template <typename SampleType>
+auto Parameters::blockUpdate() noexcept -> void {
+    TRACE_SCOPE("Parameters::blockUpdate");
+    this->getStream<SampleType>().setParameters(this->getStreamParameters());
+}
 
-    if (panningLaw == "triangle") {
-        PanningLaw::trianglePanning(this->pan, this->panL, this->panR);
-    } else if (panningLaw == "linear") {
-        PanningLaw::linearPanning(this->pan, this->panL, this->panR);
-    } else {
-        PanningLaw::constantPowerPanning(this->pan, this->panL, this->panR);
-    }
-}
\ No newline at end of file
+template auto Parameters::setHostInfo<float>(double, std::optional<double>, const AudioPlayHead::TimeSignature&, bool) noexcept -> void;
+template auto Parameters::setHostInfo<double>(double, std::optional<double>, const AudioPlayHead::TimeSignature&, bool) noexcept -> void;
+template auto Parameters::blockUpdate<float>() noexcept -> void;
+template auto Parameters::blockUpdate<double>() noexcept -> void;
@@ -1,11 +1,13 @@
 #pragma once
 #include <JuceHeader.h>
+#include <optional>
 #include "ParameterIDs.hpp"
-#include "LFO.hpp"
+#include "StreamProcessor.hpp"
+#include "RealtimeLog.hpp"
 
 class Parameters {
 public:
-    Parameters(AudioProcessorValueTreeState& tree);
+    Parameters(AudioProcessorValueTreeState& tree, RealtimeLog& realtimeLog);
     ~Parameters() = default;
 
     static auto createParameterLayout() -> AudioProcessorValueTreeState::ParameterLayout;
@@ -13,26 +15,35 @@ public:
     auto prepareToPlay(double sampleRate, int blockSize) noexcept -> void;
     auto reset() noexcept -> void;
     auto init() noexcept -> void;
+
+    template <typename SampleType>
     auto blockUpdate() noexcept -> void;
-    auto update() noexcept -> void;
-    auto setHostInfo(double bpm, double ppq, const AudioPlayHead::TimeSignature& timeSignature) noexcept -> void;
 
-    auto getDefaultParameter(const Array<var>& args, 
-        WebBrowserComponent::NativeFunctionCompletion completion) -> void;
+    template <typename SampleType>
+    auto setHostInfo(double bpm, std::optional<double> ppq, const AudioPlayHead::TimeSignature& timeSignature, bool isPlaying) noexcept -> void;
+
+    template <typename SampleType>
+    auto getStream() noexcept -> StreamProcessor<SampleType>& {
+        if constexpr (std::is_same_v<SampleType, double>) {
+            return this->doubleStream;
+        } else {
+            return this->floatStream;
+        }
+    }
+
+    auto getStreamParameters() const noexcept -> StreamParameters;
 
     static ParameterIDs paramIDs;
 
-    float gain = 1.0f;
+    KernelISA kernelISA = KernelISA::scalar;
+    ModulationScope modulationScope;
+
     AudioParameterFloat* gainParam;
     AudioParameterChoice* gainCurveParam;
 
-    float boost = 0.0f;
     AudioParameterFloat* boostParam;
     AudioParameterChoice* boostCurveParam;
 
-    float pan = 0.0f;
-    float panL = 0.0f;
-    float panR = 1.0f;
     AudioParameterFloat* panParam;
     AudioParameterChoice* panningLawParam;
 
@@ -44,23 +55,26 @@ public:
     AudioParameterFloat* panLFORateParam;
     AudioParameterFloat*  panLFOAmountParam;
 
+    std::array<AudioParameterChoice*, StreamParameters::numLFOs - 2> auxLFOTypeParams;
+    std::array<AudioParameterFloat*, StreamParameters::numLFOs - 2> auxLFORateParams;
+
+    std::array<AudioParameterChoice*, StreamParameters::numRoutings> modSourceParams;
+    std::array<AudioParameterChoice*, StreamParameters::numRoutings> modDestinationParams;
+    std::array<AudioParameterFloat*, StreamParameters::numRoutings> modDepthParams;
+
+    AudioParameterFloat* duckAmountParam;
+    AudioParameterFloat* duckAttackParam;
+    AudioParameterFloat* duckReleaseParam;
+
+    AudioParameterChoice* gainLFOModeParam;
+    AudioParameterFloat* gainLFOFrequencyParam;
+
 private:
     AudioProcessorValueTreeState& tree;
-    
-    LinearSmoothedValue<float> gainSmoother;
-    LinearSmoothedValue<float> boostSmoother;
-    LinearSmoothedValue<float> panSmoother;
-    LinearSmoothedValue<float> gainLFOAmountSmoother;
-    LinearSmoothedValue<float> panLFOAmountSmoother;
-
-    LFO gainLFO;
-    LFO panLFO;
-    double sampleRate = 44100.0;
-    int blockSize = 512;
-    double bpm = 150.0;
-    double ppq = 0.0;
-    double internalPPQ = 0.0;
-    AudioPlayHead::TimeSignature timeSignature{4, 4};
+    RealtimeLog& realtimeLog;
+
+    StreamProcessor<float> floatStream;
+    StreamProcessor<double> doubleStream;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Parameters)
 };
\ No newline at end of file
@@ -1,12 +1,14 @@
 #include "Processor.h"
-#include "Editor.h"
-#include "Functions.hpp"
+#if JUCE_WEB_BROWSER
+    #include "Editor.h"
+#endif
 
 Processor::Processor() : AudioProcessor(
     BusesProperties()
         .withInput("Input", AudioChannelSet::stereo(), true)
         .withOutput("Output", AudioChannelSet::stereo(), true)
-    ), parameters(tree), presetManager(tree) {
+        .withInput("Sidechain", AudioChannelSet::stereo(), false)
+    ), parameters(tree, realtimeLog), presetManager(tree) {
 }
 
 Processor::~Processor() {}
@@ -14,60 +16,155 @@ Processor::~Processor() {}
 auto Processor::prepareToPlay(double sampleRate, int samplesPerBlock) -> void {
     this->parameters.prepareToPlay(sampleRate, samplesPerBlock);
     this->parameters.reset();
+    this->blockTimer.reset();
 }
 
 auto Processor::releaseResources() -> void {}
 
-auto Processor::getHostInfo() noexcept -> std::tuple<double, double, TimeSignature> {
+auto Processor::getHostInfo() noexcept -> std::tuple<double, std::optional<double>, TimeSignature, bool> {
     double bpm = 150.0;
-    double ppq = 0.0;
+    std::optional<double> ppq;
     TimeSignature timeSignature{4, 4};
+    bool isPlaying = false;
 
     if (auto* playhead = this->getPlayHead()) {
         auto info = playhead->getPosition().orFallback(AudioPlayHead::PositionInfo{});
         bpm = info.getBpm().orFallback(150.0);
-        ppq = info.getPpqPosition().orFallback(0.0);
+        if (auto position = info.getPpqPosition()) {
+            ppq = *position;
+        }
         timeSignature = info.getTimeSignature().orFallback(TimeSignature{4, 4});
+        isPlaying = info.getIsPlaying();
     }
 
-    return {bpm, ppq, timeSignature};
+    return {bpm, ppq, timeSignature, isPlaying};
 }
 
 auto Processor::processBlock(AudioBuffer<float>& buffer, [[maybe_unused]] MidiBuffer& midiMessages) -> void {
+    TRACE_SCOPE("Processor::processBlock");
+    this->processSamples(buffer);
+}
+
+auto Processor::processBlock(AudioBuffer<double>& buffer, [[maybe_unused]] MidiBuffer& midiMessages) -> void {
+    TRACE_SCOPE("Processor::processBlock");
+    this->processSamples(buffer);
+}
+
+template <typename SampleType>
+auto Processor::processSamples(AudioBuffer<SampleType>& buffer) -> void {
     ScopedNoDenormals noDenormals;
+    auto startTicks = Time::getHighResolutionTicks();
 
     auto mainInput = this->getBusBuffer(buffer, true, 0);
     auto mainOutput = this->getBusBuffer(buffer, false, 0);
 
-    const float* inputL = mainInput.getReadPointer(0);
-    const float* inputR = mainInput.getNumChannels() > 1 ? mainInput.getReadPointer(1) : inputL;
+    const SampleType* inputL = mainInput.getReadPointer(0);
+    const SampleType* inputR = mainInput.getNumChannels() > 1 ? mainInput.getReadPointer(1) : inputL;
 
-    float* outputL = mainOutput.getWritePointer(0);
-    float* outputR = mainOutput.getNumChannels() > 1 ? mainOutput.getWritePointer(1) : outputL;
+    SampleType* outputL = mainOutput.getWritePointer(0);
+    SampleType* outputR = mainOutput.getNumChannels() > 1 ? mainOutput.getWritePointer(1) : outputL;
 
-    auto [bpm, ppq, timeSignature] = this->getHostInfo();
-    this->parameters.setHostInfo(bpm, ppq, timeSignature);
-    this->parameters.blockUpdate();
+    this->updateParameters<SampleType>();
 
-    for (int sample = 0; sample < buffer.getNumSamples(); sample++) {
-        this->parameters.update();
+    auto& stream = this->parameters.getStream<SampleType>();
+    int numSamples = buffer.getNumSamples();
 
-        float gain = this->parameters.gain * this->parameters.boost;
+    // A disabled sidechain bus has no channels, the detector then costs nothing. With a mono main
+    // input the host buffer shares channels between buses, so the sidechain's first channel is the
+    // same memory as outputR. That is safe without a copy because StreamProcessor detects each
+    // chunk of the sidechain before it writes the output for that chunk, and never reads back
+    if (this->getBusCount(true) > 1) {
+        auto sidechain = this->getBusBuffer(buffer, true, 1);
+        if (sidechain.getNumChannels() > 0) {
+            stream.setSidechain(sidechain.getReadPointer(0), sidechain.getNumChannels() > 1 ? sidechain.getReadPointer(1) : nullptr);
+        }
+    }
+
+    stream.process(inputL, inputR, outputL, outputR, numSamples);
 
-        outputL[sample] = inputL[sample] * gain * this->parameters.panL;
-        outputR[sample] = inputR[sample] * gain * this->parameters.panR;
+    auto repairs = this->audioSafety.process(mainOutput, stream.getKernels());
+    if (repairs.repairedBlocks > 0) {
+        this->realtimeLog.push(LogEvent::audioRepair, static_cast<double>(repairs.nonFiniteSamples), 
+            static_cast<double>(repairs.outOfRangeSamples));
     }
- 
-    #if JUCE_DEBUG
-        Functions::checkAudioSafety(buffer);
-    #endif
+
+    this->finishBlock(numSamples, startTicks);
 }
 
+auto Processor::processInterleaved(void* frames, PCMFormat format, int numFrames) -> void {
+    TRACE_SCOPE("Processor::processInterleaved");
+    ScopedNoDenormals noDenormals;
+    auto startTicks = Time::getHighResolutionTicks();
+
+    this->updateParameters<float>();
+
+    auto& stream = this->parameters.getStream<float>();
+    stream.processInterleaved(frames, format, numFrames);
+
+    // Integer PCM saturates in the kernel, only float frames can carry non-finite or runaway samples
+    if (format == PCMFormat::float32) {
+        float* samples[] = {static_cast<float*>(frames)};
+        AudioBuffer<float> interleaved{samples, 1, numFrames * 2};
+
+        auto repairs = this->audioSafety.process(interleaved, stream.getKernels());
+        if (repairs.repairedBlocks > 0) {
+            this->realtimeLog.push(LogEvent::audioRepair, static_cast<double>(repairs.nonFiniteSamples), 
+                static_cast<double>(repairs.outOfRangeSamples));
+        }
+    }
+
+    this->finishBlock(numFrames, startTicks);
+}
+
+template <typename SampleType>
+auto Processor::updateParameters() -> void {
+    auto [bpm, ppq, timeSignature, isPlaying] = this->getHostInfo();
+    this->parameters.setHostInfo<SampleType>(bpm, ppq, timeSignature, isPlaying);
+    this->parameters.blockUpdate<SampleType>();
+}
+
+auto Processor::finishBlock(int numSamples, int64 startTicks) -> void {
+    int presetGeneration = this->presetManager.presetGeneration.load(std::memory_order_acquire);
+    if (presetGeneration != this->lastPresetGeneration) {
+        this->lastPresetGeneration = presetGeneration;
+        this->realtimeLog.push(LogEvent::presetApplied, static_cast<double>(presetGeneration));
+    }
+
+    this->blockTimer.record(numSamples, this->getSampleRate(), Time::getHighResolutionTicks() - startTicks);
+}
+
+#if JUCE_WEB_BROWSER
+    auto Processor::getPerformanceStats([[maybe_unused]] const Array<var>& args,
+        WebBrowserComponent::NativeFunctionCompletion completion) -> void {
+        auto snapshot = this->blockTimer.getSnapshot();
+        auto counters = this->audioSafety.getCounters();
+        auto obj = std::make_unique<DynamicObject>();
+
+        obj->setProperty("blocks", static_cast<int64>(snapshot.blocks));
+        obj->setProperty("samples", static_cast<int64>(snapshot.samples));
+        obj->setProperty("lastNsPerSample", snapshot.lastNsPerSample);
+        obj->setProperty("averageNsPerSample", snapshot.averageNsPerSample);
+        obj->setProperty("maxNsPerSample", snapshot.maxNsPerSample);
+        obj->setProperty("p50NsPerSample", snapshot.p50NsPerSample);
+        obj->setProperty("p90NsPerSample", snapshot.p90NsPerSample);
+        obj->setProperty("p99NsPerSample", snapshot.p99NsPerSample);
+        obj->setProperty("cpuLoad", snapshot.cpuLoad);
+        obj->setProperty("nonFiniteSamples", static_cast<int64>(counters.nonFiniteSamples));
+        obj->setProperty("outOfRangeSamples", static_cast<int64>(counters.outOfRangeSamples));
+        obj->setProperty("repairedBlocks", static_cast<int64>(counters.repairedBlocks));
+
+        completion(var{obj.release()});
+    }
+#endif
+
 auto Processor::isBusesLayoutSupported(const BusesLayout& layouts) const -> bool {
     auto mono = AudioChannelSet::mono();
     auto stereo = AudioChannelSet::stereo();
     auto mainIn = layouts.getMainInputChannelSet();
     auto mainOut = layouts.getMainOutputChannelSet();
+    auto sidechain = layouts.getChannelSet(true, 1);
+
+    if (!sidechain.isDisabled() && sidechain != mono && sidechain != stereo) return false;
 
     if (mainIn == mono && mainOut == mono) return true;
     if (mainIn == mono && mainOut == stereo) return true;
@@ -76,7 +173,7 @@ auto Processor::isBusesLayoutSupported(const BusesLayout& layouts) const -> bool
 }
 
 auto Processor::getNumPrograms() -> int {
-    return static_cast<int>(this->presetManager.factoryPresets.size());
+    return PresetManager::getNumFactoryPrograms();
 }
 
 auto Processor::getCurrentProgram() -> int {
@@ -89,15 +186,17 @@ auto Processor::setCurrentProgram(int index) -> void {
 }
 
 auto Processor::getProgramName(int index) -> const String {
-    int safeIndex = jlimit(0, this->getNumPrograms() - 1, index);
-    auto presetName = this->presetManager.factoryPresetNames[static_cast<size_t>(safeIndex)];
-    return Functions::replaceChar(presetName, '/', '-');
+    return PresetManager::getFactoryProgramName(index);
 }
 
 auto Processor::changeProgramName([[maybe_unused]] int index, [[maybe_unused]] const String& newName) -> void {}
 
 auto Processor::createEditor() -> AudioProcessorEditor* {
-    return new Editor(*this);
+    #if JUCE_WEB_BROWSER
+        return new Editor(*this);
+    #else
+        return nullptr;
+    #endif
 }
 
 auto Processor::getStateInformation(MemoryBlock& destData) -> void {
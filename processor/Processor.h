@@ -2,6 +2,13 @@
 #include <JuceHeader.h>
 #include "Parameters.h"
 #include "PresetManager.h"
+#include "AudioSafety.hpp"
+#include "RealtimeLog.hpp"
+#include "BlockTimer.hpp"
+#include "Trace.hpp"
+#if JUCE_WEB_BROWSER
+  #include "WebviewPool.h"
+#endif
 
 using TimeSignature = AudioPlayHead::TimeSignature;
 
@@ -13,12 +20,15 @@ public:
   auto prepareToPlay(double sampleRate, int samplesPerBlock) -> void override;
   auto releaseResources() -> void override;
   auto processBlock(AudioBuffer<float>&, MidiBuffer&) -> void override;
-  auto getHostInfo() noexcept -> std::tuple<double, double, TimeSignature>;
+  auto processBlock(AudioBuffer<double>&, MidiBuffer&) -> void override;
+  auto processInterleaved(void* frames, PCMFormat format, int numFrames) -> void;
+  auto getHostInfo() noexcept -> std::tuple<double, std::optional<double>, TimeSignature, bool>;
 
   auto isBusesLayoutSupported (const BusesLayout& layouts) const -> bool override;
   auto createEditor() -> AudioProcessorEditor* override;
 
-  inline auto hasEditor() const -> bool override { return true; }
+  inline auto supportsDoublePrecisionProcessing() const -> bool override { return true; }
+  inline auto hasEditor() const -> bool override { return JUCE_WEB_BROWSER; }
   inline auto getName() const -> const String override { return JucePlugin_Name; }
   inline auto acceptsMidi() const -> bool override { return false; }
   inline auto producesMidi() const -> bool override { return false; }
@@ -34,13 +44,38 @@ public:
   auto getStateInformation(MemoryBlock& destData) -> void override;
   auto setStateInformation(const void* data, int sizeInBytes) -> void override;
 
+  #if JUCE_WEB_BROWSER
+    // Block timing plus the audio safety counters, polled by the CPU meter
+    auto getPerformanceStats(const Array<var>& args, WebBrowserComponent::NativeFunctionCompletion completion) -> void;
+  #endif
+
+  TraceSession traceSession;
+  RealtimeLog realtimeLog;
+
   AudioProcessorValueTreeState tree {
     *this, nullptr, "Parameters", Parameters::createParameterLayout()
   };
 
   Parameters parameters;
   PresetManager presetManager;
+  AudioSafety audioSafety;
+  BlockTimer blockTimer;
+
+  #if JUCE_WEB_BROWSER
+    // Keeps the loaded webviews alive between editors, the pool creates nothing until an editor opens
+    SharedResourcePointer<WebviewPool> webviewPool;
+  #endif
 
 private:
+  int lastPresetGeneration = 0;
+
+  template <typename SampleType>
+  auto processSamples(AudioBuffer<SampleType>& buffer) -> void;
+
+  template <typename SampleType>
+  auto updateParameters() -> void;
+
+  auto finishBlock(int numSamples, int64 startTicks) -> void;
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Processor)
 };
\ No newline at end of file
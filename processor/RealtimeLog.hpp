@@ -0,0 +1,187 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "Settings.hpp"
+
+#ifndef GAIN_BOOSTER_REALTIME_LOG
+    #define GAIN_BOOSTER_REALTIME_LOG 1
+#endif
+
+enum class LogEvent : uint32 {
+    audioRepair,
+    transportJump,
+    lfoRetrigger,
+    presetApplied
+};
+
+#if GAIN_BOOSTER_REALTIME_LOG
+
+class RealtimeLog;
+
+class RealtimeLogWriter : private Thread {
+public:
+    static constexpr int64 maxFileSize = 1024 * 1024;
+    static constexpr int numRotatedFiles = 3;
+
+    RealtimeLogWriter() : Thread("Gain Booster Log") {
+        this->startThread(Thread::Priority::background);
+    }
+
+    ~RealtimeLogWriter() override {
+        this->stopThread(2000);
+    }
+
+    auto addLog(RealtimeLog* log) -> void {
+        const ScopedLock scopedLock{this->lock};
+        this->logs.addIfNotAlreadyThere(log);
+    }
+
+    auto removeLog(RealtimeLog* log) -> void {
+        const ScopedLock scopedLock{this->lock};
+        this->logs.removeFirstMatchingValue(log);
+    }
+
+    static auto getLogFile() -> File {
+        return Settings::getSettingsFile().getSiblingFile("audio.log");
+    }
+
+private:
+    CriticalSection lock;
+    Array<RealtimeLog*> logs;
+
+    auto run() -> void override {
+        while (!this->threadShouldExit()) {
+            this->wait(250);
+            this->drain();
+        }
+        this->drain();
+    }
+
+    auto drain() -> void;
+    auto rotate(const File& file) -> void;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeLogWriter)
+};
+
+class RealtimeLog {
+public:
+    struct Record {
+        int64 ticks;
+        LogEvent event;
+        double values[2];
+    };
+
+    static constexpr int capacity = 1024;
+
+    RealtimeLog() : instanceID(RealtimeLog::nextInstanceID++) {
+        this->writer->addLog(this);
+    }
+
+    ~RealtimeLog() {
+        this->writer->removeLog(this);
+    }
+
+    auto push(LogEvent event, double first = 0.0, double second = 0.0) noexcept -> void {
+        auto scope = this->fifo.write(1);
+
+        if (scope.blockSize1 > 0) {
+            this->records[static_cast<size_t>(scope.startIndex1)] = {Time::getHighResolutionTicks(), event, {first, second}};
+        } else {
+            this->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename Callback>
+    auto read(Callback&& callback) -> void {
+        auto scope = this->fifo.read(this->fifo.getNumReady());
+        scope.forEach([&](int index) { callback(this->records[static_cast<size_t>(index)]); });
+    }
+
+    auto takeDroppedCount() noexcept -> uint32 {
+        return this->dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+    const int instanceID;
+
+private:
+    static inline std::atomic<int> nextInstanceID{1};
+
+    AbstractFifo fifo{capacity};
+    std::array<Record, capacity> records;
+    std::atomic<uint32> dropped{0};
+    SharedResourcePointer<RealtimeLogWriter> writer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeLog)
+};
+
+inline auto RealtimeLogWriter::drain() -> void {
+    String text;
+
+    auto nowTicks = Time::getHighResolutionTicks();
+    auto now = Time::getCurrentTime();
+
+    auto describe = [](const RealtimeLog::Record& record) -> String {
+        switch (record.event) {
+            case LogEvent::audioRepair:
+                return String::formatted("Audio repair: %.0f non-finite, %.0f out of range", record.values[0], record.values[1]);
+            case LogEvent::transportJump:
+                return String::formatted("Transport jump: ppq %.3f -> %.3f", record.values[0], record.values[1]);
+            case LogEvent::lfoRetrigger:
+                return String::formatted("LFO %.0f retriggered at ppq %.3f", record.values[0], record.values[1]);
+            case LogEvent::presetApplied:
+                return String::formatted("Preset snapshot %.0f applied", record.values[0]);
+        }
+        return {};
+    };
+
+    {
+        const ScopedLock scopedLock{this->lock};
+
+        for (auto* log : this->logs) {
+            auto prefix = "[instance " + String(log->instanceID) + "] ";
+
+            log->read([&](const RealtimeLog::Record& record) {
+                auto age = Time::highResolutionTicksToSeconds(nowTicks - record.ticks);
+                auto time = now - RelativeTime::seconds(age);
+                text << time.toISO8601(true) << " " << prefix << describe(record) << newLine;
+            });
+
+            if (auto dropped = log->takeDroppedCount(); dropped > 0) {
+                text << now.toISO8601(true) << " " << prefix << "Dropped " << static_cast<int>(dropped) << " records" << newLine;
+            }
+        }
+    }
+
+    if (text.isEmpty()) return;
+
+    auto file = RealtimeLogWriter::getLogFile();
+    file.getParentDirectory().createDirectory();
+    if (file.getSize() > RealtimeLogWriter::maxFileSize) this->rotate(file);
+
+    file.appendText(text, false, false, "\n");
+}
+
+inline auto RealtimeLogWriter::rotate(const File& file) -> void {
+    auto rotatedFile = [&file](int index) {
+        return file.getSiblingFile(file.getFileNameWithoutExtension() + "." + String(index) + file.getFileExtension());
+    };
+
+    rotatedFile(RealtimeLogWriter::numRotatedFiles).deleteFile();
+
+    for (int index = RealtimeLogWriter::numRotatedFiles - 1; index >= 1; index--) {
+        rotatedFile(index).moveFileTo(rotatedFile(index + 1));
+    }
+
+    file.moveFileTo(rotatedFile(1));
+}
+
+#else
+
+class RealtimeLog {
+public:
+    inline auto push([[maybe_unused]] LogEvent event, [[maybe_unused]] double first = 0.0,
+        [[maybe_unused]] double second = 0.0) noexcept -> void {}
+};
+
+#endif
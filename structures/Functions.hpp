@@ -43,25 +43,6 @@ public:
         return "";
     }
 
-    static auto checkAudioSafety(AudioBuffer<float>& buffer) -> void {
-        for (int channel = 0; channel < buffer.getNumChannels(); channel++) {
-            float* channelData = buffer.getWritePointer(channel);
-            for (int sample = 0; sample < buffer.getNumSamples(); sample++) {
-                float value = channelData[sample];
-                if (std::isnan(value)) {
-                    Logger::outputDebugString("NaN detected");
-                    return buffer.clear();
-                } else if (std::isinf(value)) {
-                    Logger::outputDebugString("Inf detected");
-                    return buffer.clear();
-                } else if (value < -2.0f || value > 2.0f) {
-                    Logger::outputDebugString("Sample out of range");
-                    return buffer.clear();
-                }
-            }
-        }
-    }
-
     static auto displayPercent(float value, int) -> String {
         return String::formatted("%.0f%%", value * 100.0f);
     }
@@ -139,6 +120,34 @@ public:
         return text.getFloatValue();
     }
 
+    static auto displayMilliseconds(float value, int) -> String {
+        return value < 10.0f ? String::formatted("%.1fms", value) : String::formatted("%.0fms", value);
+    }
+
+    static auto parseMilliseconds(const String& text) -> float {
+        auto clean = text.trim();
+        if (clean.endsWithIgnoreCase("ms")) {
+            clean = clean.dropLastCharacters(2).trim();
+        }
+        return clean.getFloatValue();
+    }
+
+    static auto displayHertz(float value, int) -> String {
+        if (value >= 1000.0f) return String::formatted("%.2fkHz", value / 1000.0f);
+        return value < 10.0f ? String::formatted("%.2fHz", value) : String::formatted("%.1fHz", value);
+    }
+
+    static auto parseHertz(const String& text) -> float {
+        auto clean = text.trim();
+        if (clean.endsWithIgnoreCase("Hz")) {
+            clean = clean.dropLastCharacters(2).trim();
+        }
+        if (clean.endsWithIgnoreCase("k")) {
+            return clean.dropLastCharacters(1).trim().getFloatValue() * 1000.0f;
+        }
+        return clean.getFloatValue();
+    }
+
     static auto getDownloadsFolder() -> File {
         #if JUCE_WINDOWS
             PWSTR path = nullptr;
@@ -0,0 +1,84 @@
+export type ModulationTarget = "gain" | "pan"
+
+export interface ModulationHistory {
+    min: Float32Array
+    max: Float32Array
+    phase: number
+    head: number
+}
+
+type HistoryListener = () => void
+
+const gainScale = 4
+const valuesPerColumn = 6
+
+/*
+ * Rolling history of the modulationScope events. Each event is a base64 string of little-endian
+ * uint16 values, a [numColumns, columnRate] header and six quantised values per column, so the
+ * decoded columns are written straight into fixed ring buffers without any per-column objects.
+ */
+class ModulationStream {
+    public readonly length = 480
+    private histories: Record<ModulationTarget, ModulationHistory> = {
+        gain: this.createHistory(),
+        pan: this.createHistory()
+    }
+    private listeners = new Set<HistoryListener>()
+    private listening = false
+
+    public getHistory = (target: ModulationTarget) => this.histories[target]
+
+    public subscribe = (listener: HistoryListener) => {
+        if (!this.listening) {
+            window.__JUCE__.backend.addEventListener("modulationScope", this.receive)
+            window.__JUCE__.backend.addEventListener("editorAttached", this.clear)
+            this.listening = true
+        }
+        this.listeners.add(listener)
+        return () => {this.listeners.delete(listener)}
+    }
+
+    private createHistory() {
+        return {min: new Float32Array(this.length), max: new Float32Array(this.length), phase: 0, head: 0}
+    }
+
+    // A pooled page moved to another editor must not show the previous processor's history
+    private clear = () => {
+        for (const history of Object.values(this.histories)) {
+            history.min.fill(0)
+            history.max.fill(0)
+            history.phase = 0
+        }
+        this.listeners.forEach((listener) => listener())
+    }
+
+    private receive = (payload: string) => {
+        const binary = atob(payload)
+        const bytes = new Uint8Array(binary.length)
+        for (let i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i)
+        const view = new DataView(bytes.buffer)
+        if (view.byteLength < 4) return
+
+        const numColumns = Math.min(view.getUint16(0, true), (view.byteLength - 4) / (2 * valuesPerColumn))
+        const value = (column: number, index: number) => view.getUint16(4 + 2 * (column * valuesPerColumn + index), true) / 65535
+        const gain = this.histories.gain
+        const pan = this.histories.pan
+
+        for (let column = 0; column < numColumns; column++) {
+            gain.min[gain.head] = value(column, 0) * gainScale
+            gain.max[gain.head] = value(column, 1) * gainScale
+            pan.min[pan.head] = value(column, 2) * 2 - 1
+            pan.max[pan.head] = value(column, 3) * 2 - 1
+            gain.head = (gain.head + 1) % this.length
+            pan.head = (pan.head + 1) % this.length
+        }
+
+        if (numColumns > 0) {
+            gain.phase = value(numColumns - 1, 4)
+            pan.phase = value(numColumns - 1, 5)
+        }
+        this.listeners.forEach((listener) => listener())
+    }
+}
+
+export default new ModulationStream()
\ No newline at end of file
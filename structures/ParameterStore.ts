@@ -0,0 +1,144 @@
+import * as JUCE from "juce-framework-frontend-mirror"
+
+export interface ParameterSlot {
+    id: string
+    name: string
+    label: string
+    start: number
+    end: number
+    interval: number
+    skew: number
+    numSteps: number
+    choices: string[]
+    defaultValue: number
+    value: number
+}
+
+interface ParameterMetadata {
+    generation: number
+    parameters: ParameterSlot[]
+}
+
+type SlotListener = (slot: ParameterSlot) => void
+
+const getParameterMetadata = JUCE.getNativeFunction("getParameterMetadata")
+const syncParameters = JUCE.getNativeFunction("syncParameters")
+
+const enum Operation {
+    SetValue = 0,
+    BeginGesture = 1,
+    EndGesture = 2
+}
+
+/*
+ * Mirror of every parameter in one place. All metadata comes from a single call at startup, host changes
+ * arrive as one parameterSync batch per frame, and edits made here are queued and flushed as one
+ * syncParameters call per animation frame, so a drag costs at most one message per frame.
+ *
+ * The page can outlive its editor in the webview pool. editorAttached means another processor now
+ * owns it, so queued edits are dropped and the metadata is fetched again under the new generation.
+ */
+class ParameterStore {
+    private slots: ParameterSlot[] = []
+    private slotForID = new Map<string, number>()
+    private listeners = new Map<string, Set<SlotListener>>()
+    private pending: number[] = []
+    private pendingSet = new Map<number, number>()
+    private generation = 0
+    private frame = 0
+    private ready: Promise<void> | null = null
+
+    public load = () => {
+        if (!this.ready) {
+            window.__JUCE__.backend.addEventListener("parameterSync", this.receive)
+            window.__JUCE__.backend.addEventListener("editorAttached", this.attach)
+            this.ready = this.fetch()
+        }
+        return this.ready
+    }
+
+    public getSlot = (parameterID: string) => {
+        const index = this.slotForID.get(parameterID)
+        return index === undefined ? null : this.slots[index]
+    }
+
+    public subscribe = (parameterID: string, listener: SlotListener) => {
+        if (!this.listeners.has(parameterID)) this.listeners.set(parameterID, new Set())
+        this.listeners.get(parameterID)!.add(listener)
+        return () => {this.listeners.get(parameterID)?.delete(listener)}
+    }
+
+    public setValue = (parameterID: string, value: number) => {
+        const index = this.slotForID.get(parameterID)
+        if (index === undefined) return
+        this.slots[index].value = value
+
+        // A newer value replaces the queued one unless a gesture was queued after it, which keeps the host's gesture order
+        const queued = this.pendingSet.get(index)
+        if (queued !== undefined) {
+            this.pending[queued + 2] = value
+        } else {
+            this.pendingSet.set(index, this.pending.length)
+            this.pending.push(Operation.SetValue, index, value)
+        }
+        this.schedule()
+    }
+
+    public beginGesture = (parameterID: string) => this.queueGesture(parameterID, Operation.BeginGesture)
+
+    public endGesture = (parameterID: string) => this.queueGesture(parameterID, Operation.EndGesture)
+
+    private fetch = async () => {
+        // An idle pooled webview has no editor and gets an empty reply
+        const metadata: ParameterMetadata | null = await getParameterMetadata()
+        this.generation = metadata?.generation ?? 0
+        this.slots = metadata?.parameters ?? []
+        this.slotForID = new Map(this.slots.map((slot, index) => [slot.id, index]))
+        this.slots.forEach((slot) => this.notify(slot))
+    }
+
+    private attach = () => {
+        this.pending = []
+        this.pendingSet.clear()
+        this.ready = this.fetch()
+    }
+
+    private notify = (slot: ParameterSlot) => {
+        this.listeners.get(slot.id)?.forEach((listener) => listener(slot))
+    }
+
+    private queueGesture = (parameterID: string, operation: Operation) => {
+        const index = this.slotForID.get(parameterID)
+        if (index === undefined) return
+        this.pendingSet.delete(index)
+        this.pending.push(operation, index, 0)
+        this.schedule()
+    }
+
+    private schedule = () => {
+        if (!this.frame) this.frame = requestAnimationFrame(this.flush)
+    }
+
+    private flush = async () => {
+        this.frame = 0
+        if (!this.pending.length) return
+        const batch = this.pending
+        this.pending = []
+        this.pendingSet.clear()
+        const generation = await syncParameters(batch, this.generation)
+        if (generation !== this.generation) this.attach()
+    }
+
+    private receive = (batch: number[]) => {
+        for (let i = 0; i + 1 < batch.length; i += 2) {
+            const index = batch[i]
+            const slot = this.slots[index]
+            // A value still queued here is newer than what the host last saw
+            if (!slot || this.pendingSet.has(index)) continue
+            slot.value = batch[i + 1]
+            this.notify(slot)
+        }
+    }
+}
+
+export default new ParameterStore()
\ No newline at end of file
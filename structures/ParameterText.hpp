@@ -0,0 +1,155 @@
+#pragma once
+#include <JuceHeader.h>
+#include <unordered_map>
+#include "Functions.hpp"
+
+/*
+ * Host-facing text for the plugin's quantised parameters. Hosts ask for parameter text on every
+ * automation redraw, so each display format is rendered once into a table indexed by the quantised
+ * value, and typed text that matches a table entry maps straight back to its value. Values off the
+ * grid fall back to the formatting in Functions.
+ */
+class ParameterText {
+public:
+    static auto displayPercent(float value, int) -> String {
+        const auto& table = ParameterText::getPercentTable();
+        auto index = static_cast<int>(std::lround(value * 100.0f));
+        return table.getText(index, [value] { return Functions::displayPercent(value, 0); });
+    }
+
+    static auto parsePercent(const String& text) -> float {
+        return ParameterText::getPercentTable().getValue(text, Functions::parsePercent);
+    }
+
+    static auto displayDecibels(float value, int) -> String {
+        const auto& table = ParameterText::getDecibelTable();
+        auto index = static_cast<int>(std::lround(value * 100.0f));
+        return table.getText(index, [value] { return Functions::displayDecibels(value, 0); });
+    }
+
+    static auto parseDecibels(const String& text) -> float {
+        return ParameterText::getDecibelTable().getValue(text, Functions::parseDecibels);
+    }
+
+    static auto displayPan(float value, int) -> String {
+        const auto& table = ParameterText::getPanTable();
+        // Truncation towards zero, the same positions Functions::displayPan prints
+        auto index = static_cast<int>(value * 50.0f);
+        return table.getText(index, [value] { return Functions::displayPan(value, 0); });
+    }
+
+    static auto parsePan(const String& text) -> float {
+        return ParameterText::getPanTable().getValue(text.toUpperCase(), Functions::parsePan);
+    }
+
+    static auto displayLFORate(float value, int) -> String {
+        const auto& divisions = ParameterText::getLFODivisions();
+        auto it = std::lower_bound(divisions.values.begin(), divisions.values.end(), value - ParameterText::lfoEpsilon);
+
+        if (it != divisions.values.end() && std::abs(*it - value) < ParameterText::lfoEpsilon) {
+            return divisions.texts[static_cast<size_t>(it - divisions.values.begin())];
+        }
+        return String(value);
+    }
+
+    static auto parseLFORate(const String& text) -> float {
+        const auto& divisions = ParameterText::getLFODivisions();
+        auto it = divisions.lookup.find(text.trim());
+        return it != divisions.lookup.end() ? it->second : Functions::parseLFORate(text);
+    }
+
+private:
+    static constexpr float lfoEpsilon = 0.0001f;
+
+    struct Table {
+        int offset = 0;
+        std::vector<String> texts;
+        std::unordered_map<String, float> lookup;
+
+        template <typename Fallback>
+        auto getText(int index, Fallback&& fallback) const -> String {
+            auto slot = index + this->offset;
+            if (slot < 0 || slot >= static_cast<int>(this->texts.size())) return fallback();
+            return this->texts[static_cast<size_t>(slot)];
+        }
+
+        template <typename Fallback>
+        auto getValue(const String& text, Fallback&& fallback) const -> float {
+            auto it = this->lookup.find(text.trim());
+            return it != this->lookup.end() ? it->second : fallback(text);
+        }
+    };
+
+    struct Divisions {
+        std::vector<float> values;
+        std::vector<String> texts;
+        std::unordered_map<String, float> lookup;
+    };
+
+    // Entries are formatted from index * step, the same float the parameter's range snaps to. Texts
+    // map back through the original parser, so several grid values sharing a text parse identically
+    template <typename Format, typename Parse>
+    static auto makeTable(int first, int last, float step, Format&& format, Parse&& parse) -> Table {
+        Table table;
+        table.offset = -first;
+        table.texts.reserve(static_cast<size_t>(last - first + 1));
+
+        for (int index = first; index <= last; index++) {
+            table.texts.push_back(format(static_cast<float>(index) * step));
+            const auto& text = table.texts.back();
+            if (table.lookup.find(text) == table.lookup.end()) table.lookup.emplace(text, parse(text));
+        }
+        return table;
+    }
+
+    static auto getPercentTable() -> const Table& {
+        static const Table table = ParameterText::makeTable(0, 100, 0.01f, [](float value) {
+            return Functions::displayPercent(value, 0);
+        }, Functions::parsePercent);
+        return table;
+    }
+
+    static auto getDecibelTable() -> const Table& {
+        static const Table table = ParameterText::makeTable(0, 1200, 0.01f, [](float value) {
+            return Functions::displayDecibels(value, 0);
+        }, Functions::parseDecibels);
+        return table;
+    }
+
+    static auto getPanTable() -> const Table& {
+        static const Table table = ParameterText::makeTable(-50, 50, 0.02f, [](float value) {
+            auto position = static_cast<int>(std::lround(value * 50.0f));
+            return position < 0 ? String(-position) + "L" : String(position) + "R";
+        }, Functions::parsePan);
+        return table;
+    }
+
+    // Musical divisions n/d with n in 1-4 and d in 1-32, sorted by value; equal values keep the
+    // first fraction in Functions::displayLFORate's search order, so 2/4 prints as 1/2
+    static auto getLFODivisions() -> const Divisions& {
+        static const Divisions divisions = [] {
+            std::vector<std::pair<float, String>> candidates;
+
+            for (int numerator = 1; numerator <= 4; numerator++) {
+                for (int denominator = 1; denominator <= 32; denominator++) {
+                    auto value = static_cast<float>(numerator) / static_cast<float>(denominator);
+                    bool seen = std::any_of(candidates.begin(), candidates.end(), [value](const auto& candidate) {
+                        return std::abs(candidate.first - value) < ParameterText::lfoEpsilon;
+                    });
+                    if (!seen) candidates.emplace_back(value, String(numerator) + "/" + String(denominator));
+                }
+            }
+
+            std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+            Divisions result;
+            for (const auto& [value, text] : candidates) {
+                result.values.push_back(value);
+                result.texts.push_back(text);
+                result.lookup.emplace(text, value);
+            }
+            return result;
+        }();
+        return divisions;
+    }
+};
@@ -0,0 +1,191 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+#ifndef GAIN_BOOSTER_TRACE
+    #define GAIN_BOOSTER_TRACE 0
+#endif
+
+#if GAIN_BOOSTER_TRACE
+
+class TraceBuffer {
+public:
+    struct Event {
+        const char* name;
+        int64 startTicks;
+        int64 endTicks;
+        uint64 threadID;
+    };
+
+    static constexpr uint64 capacity = 1 << 16;
+
+    static auto instance() -> TraceBuffer& {
+        static TraceBuffer buffer;
+        return buffer;
+    }
+
+    auto add(const char* name, int64 startTicks, int64 endTicks) noexcept -> void {
+        auto index = this->writeIndex.fetch_add(1, std::memory_order_relaxed);
+        auto& slot = this->slots[static_cast<size_t>(index & (capacity - 1))];
+
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.startTicks.store(startTicks, std::memory_order_relaxed);
+        slot.endTicks.store(endTicks, std::memory_order_relaxed);
+        slot.threadID.store(static_cast<uint64>(reinterpret_cast<pointer_sized_uint>(Thread::getCurrentThreadId())),
+            std::memory_order_relaxed);
+
+        slot.sequence.store(index + 1, std::memory_order_release);
+    }
+
+    // Reads every committed event since the last call, returns the number of events lost to wrap-around
+    template <typename Callback>
+    auto read(Callback&& callback) -> uint64 {
+        uint64 dropped = 0;
+        auto end = this->writeIndex.load(std::memory_order_acquire);
+
+        if (end - this->readIndex > capacity) {
+            dropped += end - capacity - this->readIndex;
+            this->readIndex = end - capacity;
+        }
+
+        while (this->readIndex < end) {
+            auto& slot = this->slots[static_cast<size_t>(this->readIndex & (capacity - 1))];
+            auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+            // Reserved but not yet committed, pick it up on the next read
+            if (sequence != 0 && sequence < this->readIndex + 1) break;
+
+            Event event{slot.name.load(std::memory_order_relaxed), slot.startTicks.load(std::memory_order_relaxed),
+                slot.endTicks.load(std::memory_order_relaxed), slot.threadID.load(std::memory_order_relaxed)};
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence == this->readIndex + 1 && slot.sequence.load(std::memory_order_relaxed) == sequence) {
+                callback(event);
+            } else if (sequence == 0) {
+                break;
+            } else {
+                dropped++;
+            }
+            this->readIndex++;
+        }
+
+        return dropped;
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64> sequence{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<int64> startTicks{0};
+        std::atomic<int64> endTicks{0};
+        std::atomic<uint64> threadID{0};
+    };
+
+    std::array<Slot, capacity> slots;
+    std::atomic<uint64> writeIndex{0};
+    uint64 readIndex = 0;
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) noexcept : name(name), startTicks(Time::getHighResolutionTicks()) {}
+
+    ~TraceScope() {
+        TraceBuffer::instance().add(this->name, this->startTicks, Time::getHighResolutionTicks());
+    }
+
+private:
+    const char* name;
+    int64 startTicks;
+
+    JUCE_DECLARE_NON_COPYABLE(TraceScope)
+};
+
+class TraceWriter : private Thread {
+public:
+    TraceWriter() : Thread("Gain Booster Trace") {
+        auto directory = File::getSpecialLocation(File::userApplicationDataDirectory)
+            .getChildFile(JucePlugin_Manufacturer)
+            .getChildFile(JucePlugin_Name);
+
+        directory.createDirectory();
+        this->file = directory.getNonexistentChildFile("trace-" + Time::getCurrentTime().formatted("%Y%m%d-%H%M%S"), ".json");
+        this->stream = this->file.createOutputStream();
+
+        if (this->stream != nullptr) {
+            *this->stream << "[\n";
+            this->startThread(Thread::Priority::background);
+        }
+    }
+
+    ~TraceWriter() override {
+        if (this->stream == nullptr) return;
+
+        this->stopThread(2000);
+        this->drain();
+        *this->stream << "\n]\n";
+        this->stream->flush();
+    }
+
+private:
+    File file;
+    std::unique_ptr<FileOutputStream> stream;
+    bool firstEvent = true;
+
+    auto run() -> void override {
+        while (!this->threadShouldExit()) {
+            this->wait(500);
+            this->drain();
+        }
+    }
+
+    auto drain() -> void {
+        auto toMicroseconds = [](int64 ticks) {
+            return Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+        };
+
+        auto dropped = TraceBuffer::instance().read([&](const TraceBuffer::Event& event) {
+            if (!this->firstEvent) *this->stream << ",\n";
+            this->firstEvent = false;
+
+            *this->stream << R"({"name":")" << event.name << R"(","cat":"gainbooster","ph":"X","pid":1,"tid":)"
+                << String(static_cast<int64>(event.threadID & 0x7fffffff)) << R"(,"ts":)" << String(toMicroseconds(event.startTicks), 3)
+                << R"(,"dur":)" << String(toMicroseconds(event.endTicks - event.startTicks), 3) << "}";
+        });
+
+        if (dropped > 0) {
+            if (!this->firstEvent) *this->stream << ",\n";
+            this->firstEvent = false;
+
+            *this->stream << R"({"name":"Dropped )" << String(static_cast<int64>(dropped))
+                << R"( events","cat":"gainbooster","ph":"i","s":"g","pid":1,"tid":0,"ts":)"
+                << String(toMicroseconds(Time::getHighResolutionTicks()), 3) << "}";
+        }
+
+        this->stream->flush();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceWriter)
+};
+
+class TraceSession {
+private:
+    SharedResourcePointer<TraceWriter> writer;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) const TraceScope TRACE_CONCAT(traceScope, __LINE__){name}
+
+#else
+
+class TraceSession {};
+
+#define TRACE_SCOPE(name)
+
+#endif